@@ -0,0 +1,204 @@
+#pragma once
+#include "mlfq.h"
+#include <vector>
+#include <algorithm>
+#include <type_traits>
+
+// Base time slice of a round-robin level: stored when chosen at runtime, an empty
+// base (no storage) when it is a template constant
+struct StoredTimeSlice {
+    int timeSlice;
+    explicit StoredTimeSlice(int slice) : timeSlice(slice) {}
+    int value() const { return timeSlice; }
+};
+
+template <int Quantum>
+struct FixedTimeSlice {
+    explicit FixedTimeSlice(int) {}
+    static constexpr int value() { return Quantum; }
+};
+
+// Round-Robin scheduling strategy implementation per level. Quantum 0: the time
+// slice is given at construction (runtime schemes); otherwise it is a compile-time
+// constant (pipeline.h), which the engine loop can fold in
+template <int Quantum = 0>
+class BasicCircularScheduler : public SchedulingStrategy,
+                               private std::conditional_t<Quantum == 0, StoredTimeSlice, FixedTimeSlice<Quantum>> {
+    using TimeSlice = std::conditional_t<Quantum == 0, StoredTimeSlice, FixedTimeSlice<Quantum>>;
+    static_assert(Quantum >= 0, "round-robin quantum cannot be negative");
+    static constexpr int UNLINKED = -2; // nextLink marker: task not in the ready list
+    static constexpr int NO_QUOTA = -1; // timeQuota marker: no quota entry at this level
+
+    // Ready list for THIS level: intrusive doubly linked FIFO over task IDs
+    std::vector<int> nextLink, prevLink;
+    int head = -1, tail = -1, queued = 0;
+    // Time quota remaining per task ID at THIS level (dense, indexed by task ID)
+    std::vector<int> timeQuota;
+    // Base time slice for THIS level
+    int baseTimeSlice() const { return TimeSlice::value(); }
+    // Preemption flag: task ID that must yield CPU on next selectNextTask
+    int mustYield = -1;
+
+    // Grow per-task storage when a task ID beyond the initial sizing shows up
+    void ensureCapacity(int taskId) {
+        if (taskId < static_cast<int>(timeQuota.size())) return;
+        int size = std::max(taskTable.size(), taskId + 1);
+        nextLink.resize(size, UNLINKED);
+        prevLink.resize(size, -1);
+        timeQuota.resize(size, NO_QUOTA);
+    }
+
+    bool isLinked(int taskId) const {
+        return taskId < static_cast<int>(nextLink.size()) && nextLink[taskId] != UNLINKED;
+    }
+
+    void linkBack(int taskId) {
+        prevLink[taskId] = tail;
+        nextLink[taskId] = -1;
+        if (tail != -1) nextLink[tail] = taskId; else head = taskId;
+        tail = taskId;
+        ++queued;
+    }
+
+    void unlink(int taskId) {
+        int before = prevLink[taskId], after = nextLink[taskId];
+        if (before != -1) nextLink[before] = after; else head = after;
+        if (after != -1) prevLink[after] = before; else tail = before;
+        nextLink[taskId] = UNLINKED;
+        prevLink[taskId] = -1;
+        --queued;
+    }
+
+    int popFront() {
+        int taskId = head;
+        unlink(taskId);
+        markDispatched(taskId);
+        return taskId;
+    }
+
+public:
+    BasicCircularScheduler(TaskTable& allTasks, int timeSlice = Quantum)
+        : SchedulingStrategy(allTasks), TimeSlice(timeSlice),
+          nextLink(allTasks.size(), UNLINKED), prevLink(allTasks.size(), -1),
+          timeQuota(allTasks.size(), NO_QUOTA) {}
+
+    void reset() override {
+        SchedulingStrategy::reset();
+        nextLink.assign(taskTable.size(), UNLINKED);
+        prevLink.assign(taskTable.size(), -1);
+        timeQuota.assign(taskTable.size(), NO_QUOTA);
+        head = tail = -1; queued = 0; mustYield = -1;
+    }
+
+    void saveState(SavedState& state) const override {
+        state.put(mustYield);
+        state.put(queued);
+        for (int taskId = head; taskId != -1; taskId = nextLink[taskId]) state.put(taskId);
+        // Quotas are only held by queued tasks and the one running here
+        int held = 0;
+        for (int quota : timeQuota) held += quota != NO_QUOTA;
+        state.put(held);
+        for (int taskId = 0; taskId < static_cast<int>(timeQuota.size()); ++taskId)
+            if (timeQuota[taskId] != NO_QUOTA) { state.put(taskId); state.put(timeQuota[taskId]); }
+    }
+
+    void restoreState(StateReader& state) override {
+        mustYield = state.next();
+        for (int count = state.next(); count > 0; --count) {
+            int taskId = state.next();
+            ensureCapacity(taskId);
+            linkBack(taskId);
+        }
+        for (int held = state.next(); held > 0; --held) {
+            int taskId = state.next();
+            ensureCapacity(taskId);
+            timeQuota[taskId] = state.next();
+        }
+    }
+
+    void addToQueue(int taskId) override {
+        ensureCapacity(taskId);
+        linkBack(taskId);
+        markReady(taskId);
+        if (timeQuota[taskId] == NO_QUOTA) timeQuota[taskId] = baseTimeSlice();
+    }
+
+    bool hasWaitingTasks() const override { return head != -1; }
+    int  queueLength() const override { return queued; }
+    int  peekNextTask() const override { return head; }
+
+    int selectNextTask(int currentTaskId) override {
+        // No current task running, pick first from queue
+        if (currentTaskId == -1) {
+            if (head == -1) return -1;
+            return popFront();
+        }
+
+        // Current task marked for yielding, force context switch
+        if (mustYield == currentTaskId) {
+            mustYield = -1;
+            if (head != -1) return popFront();
+            return -1; // Switch even if queue empty
+        }
+
+        // Continue with current task
+        return currentTaskId;
+    }
+
+    void processTimeUnit(int taskId) override {
+        if (taskId == -1) return;
+
+        // Consume one time unit from current level's quota
+        if (--timeQuota[taskId] == 0 && taskTable.timeLeft[taskId] > 0) {
+            // Time slice expired and task not finished
+            timeQuota[taskId] = baseTimeSlice();                            // reset quota
+            taskTable.tier[taskId]++;                                        // level degradation (the engine caps it at its depth)
+            // Don't re-queue here; global MLFQ decides new level
+            mustYield = taskId; // mark for yielding CPU on next selectNextTask
+        }
+    }
+
+    int runBudget(int taskId) const override {
+        // Remaining quota: the task yields once it reaches zero
+        int quota = taskId < static_cast<int>(timeQuota.size()) ? timeQuota[taskId] : NO_QUOTA;
+        return quota != NO_QUOTA ? quota : baseTimeSlice();
+    }
+
+    void processTimeUnits(int taskId, int units) override {
+        if (taskId == -1 || units <= 0) return;
+        // Consume all but the last unit directly; the last one may expire the quota
+        timeQuota[taskId] -= units - 1;
+        processTimeUnit(taskId);
+    }
+
+    void handleTaskExit(int taskId) override {
+        if (taskId == -1) return;
+        // Reset task's time quota
+        ensureCapacity(taskId);
+        timeQuota[taskId] = baseTimeSlice();
+        // Don't re-queue in this strategy; MLFQ decides level
+    }
+
+    void purgeTask(int taskId) override {
+        // Normally running task isn't in queue, but remove for robustness
+        if (isLinked(taskId)) {
+            unlink(taskId);
+            markDispatched(taskId);
+        }
+        if (taskId < static_cast<int>(timeQuota.size())) timeQuota[taskId] = NO_QUOTA;
+    }
+
+    void updateWaitingTimes(int runningTaskId) override {
+        for (int taskId = head; taskId != -1; taskId = nextLink[taskId]) {
+            if (taskId != runningTaskId) taskTable.delayAccumulated[taskId]++;
+        }
+    }
+
+    void accumulateWaitingTimes(int runningTaskId, int units) override {
+        for (int taskId = head; taskId != -1; taskId = nextLink[taskId]) {
+            if (taskId != runningTaskId) taskTable.delayAccumulated[taskId] += units;
+        }
+    }
+};
+
+using CircularScheduler = BasicCircularScheduler<>;
@@ -0,0 +1,54 @@
+#pragma once
+#include "mlfq.h"
+#include "taskheap.h"
+#include <vector>
+#include <climits>
+
+// Non-preemptive Shortest Job First scheduling strategy
+class MinimalJobScheduler : public SchedulingStrategy {
+    // Ready set ordered by (burstLeft, arrivalMoment, identifier)
+    IndexedTaskHeap waitingList;
+
+public:
+    explicit MinimalJobScheduler(TaskTable& tasks)
+        : SchedulingStrategy(tasks), waitingList(tasks) {}
+
+    void reset() override { SchedulingStrategy::reset(); waitingList.reset(); }
+    void refreshRank(int taskId) override { waitingList.refreshRank(taskId); }
+    void saveState(SavedState& state) const override { waitingList.saveState(state); }
+    void restoreState(StateReader& state) override { waitingList.restoreState(state); }
+    void addToQueue(int taskId) override { waitingList.push(taskId); markReady(taskId); }
+    bool hasWaitingTasks() const override { return !waitingList.empty(); }
+    int  queueLength() const override { return waitingList.size(); }
+    int  peekNextTask() const override { return waitingList.top(); }
+
+    int selectNextTask(int currentTaskId) override {
+        if (currentTaskId != -1) return currentTaskId;
+        if (waitingList.empty()) return -1;
+        int nextTask = waitingList.pop();
+        markDispatched(nextTask);
+        return nextTask;
+    }
+
+    // Never switches away from the running task on its own
+    int  runBudget(int) const override { return INT_MAX; }
+    void processTimeUnit(int) override {}
+    void processTimeUnits(int, int) override {}
+    void handleTaskExit(int) override {}
+
+    void purgeTask(int taskId) override {
+        if (waitingList.erase(taskId)) markDispatched(taskId);
+    }
+
+    void updateWaitingTimes(int runningTaskId) override {
+        waitingList.forEach([&](int taskId){
+            if (taskId != runningTaskId) taskTable.delayAccumulated[taskId]++;
+        });
+    }
+
+    void accumulateWaitingTimes(int runningTaskId, int units) override {
+        waitingList.forEach([&](int taskId){
+            if (taskId != runningTaskId) taskTable.delayAccumulated[taskId] += units;
+        });
+    }
+};
@@ -0,0 +1,64 @@
+#pragma once
+#include "mlfq.h"
+#include "taskheap.h"
+#include <vector>
+#include <climits>
+
+// Preemptive Shortest Remaining Time First scheduling strategy
+class DynamicShortestScheduler : public SchedulingStrategy {
+    // Ready set ordered by (burstLeft, arrivalMoment, identifier)
+    IndexedTaskHeap candidateList;
+
+    // Best of the running task and the queued candidates; the running task wins ties
+    int findOptimalTask(int current) const {
+        int bestCandidate = candidateList.top();
+        if (current == -1) return bestCandidate;
+        if (bestCandidate != -1 && candidateList.precedes(bestCandidate, current)) return bestCandidate;
+        return current;
+    }
+
+public:
+    explicit DynamicShortestScheduler(TaskTable& tasks)
+        : SchedulingStrategy(tasks), candidateList(tasks) {}
+
+    void reset() override { SchedulingStrategy::reset(); candidateList.reset(); }
+    void refreshRank(int taskId) override { candidateList.refreshRank(taskId); }
+    void saveState(SavedState& state) const override { candidateList.saveState(state); }
+    void restoreState(StateReader& state) override { candidateList.restoreState(state); }
+    void addToQueue(int taskId) override { candidateList.push(taskId); markReady(taskId); }
+    bool hasWaitingTasks() const override { return !candidateList.empty(); }
+    int  queueLength() const override { return candidateList.size(); }
+    int  peekNextTask() const override { return candidateList.top(); }
+
+    int selectNextTask(int currentTaskId) override {
+        if (candidateList.empty() && currentTaskId == -1) return -1;
+        int optimalTask = findOptimalTask(currentTaskId);
+        if (optimalTask == currentTaskId) return currentTaskId;
+        if (currentTaskId != -1) addToQueue(currentTaskId);
+        candidateList.erase(optimalTask);
+        markDispatched(optimalTask);
+        return optimalTask;
+    }
+
+    // Remaining time only shrinks while running: only a new candidate can preempt
+    int  runBudget(int) const override { return INT_MAX; }
+    void processTimeUnit(int) override {}
+    void processTimeUnits(int, int) override {}
+    void handleTaskExit(int) override {}
+
+    void purgeTask(int taskId) override {
+        if (candidateList.erase(taskId)) markDispatched(taskId);
+    }
+
+    void updateWaitingTimes(int activeTaskId) override {
+        candidateList.forEach([&](int taskId){
+            if (taskId != activeTaskId) taskTable.delayAccumulated[taskId]++;
+        });
+    }
+
+    void accumulateWaitingTimes(int activeTaskId, int units) override {
+        candidateList.forEach([&](int taskId){
+            if (taskId != activeTaskId) taskTable.delayAccumulated[taskId] += units;
+        });
+    }
+};
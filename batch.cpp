@@ -0,0 +1,136 @@
+#include "mlfq.h"
+#include "pool.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+
+using namespace std;
+namespace fs = std::filesystem;
+
+// Batch execution: every (input file × scheme) pair is one pool job; each worker
+// thread keeps one SimulationContext, so its task table and levels are reused
+
+namespace {
+    struct BatchEntry {
+        string inputPath, outputPath;
+        unique_ptr<PreparedWorkload> workload;  // shared by the scheme jobs
+        vector<pair<char, vector<Task>>> results;
+        vector<string> errors;   // one slot per scheme job
+        atomic<int> remaining{0};
+    };
+
+    void writeEntryReport(BatchEntry& entry, const ReportOptions& reportOptions, atomic<size_t>& failures){
+        for (const auto& error : entry.errors){
+            if (error.empty()) continue;
+            cerr << "batch: " << entry.inputPath << ": " << error << '\n';
+            ++failures;
+            return;
+        }
+        ofstream outputStream(entry.outputPath, ios::binary);
+        if (!outputStream){
+            cerr << "batch: unable to write " << entry.outputPath << '\n';
+            ++failures;
+            return;
+        }
+        writeConsolidatedReport(outputStream, entry.results, reportOptions);
+        entry.workload.reset();
+        entry.results.clear(); entry.results.shrink_to_fit();
+    }
+}
+
+vector<string> collectBatchInputs(const string& source){
+    vector<string> inputFiles;
+    if (fs::is_directory(source)){
+        for (const auto& item : fs::directory_iterator(source))
+            if (item.is_regular_file() && item.path().extension() == ".txt") inputFiles.push_back(item.path().string());
+        sort(inputFiles.begin(), inputFiles.end());
+        return inputFiles;
+    }
+
+    // Otherwise a list file: one input path per line, '#' comments allowed
+    ifstream listFile(source);
+    if (!listFile) throw runtime_error("❌ Unable to open batch source: " + source);
+    string line;
+    while (getline(listFile, line)){
+        size_t start = line.find_first_not_of(" \t\r\n");
+        if (start == string::npos || line[start] == '#') continue;
+        size_t end = line.find_last_not_of(" \t\r\n");
+        inputFiles.push_back(line.substr(start, end - start + 1));
+    }
+    return inputFiles;
+}
+
+BatchSummary runBatch(const vector<string>& inputFiles, const string& outputDirectory, const vector<char>& schemes,
+                      const SimulationOptions& options, const ReportOptions& reportOptions, unsigned threadCount){
+    auto startTime = chrono::steady_clock::now();
+    fs::create_directories(outputDirectory);
+
+    // Reports are named after the input file: a second input with an already used name
+    // (a/x.txt, b/x.txt in a list file) is a failure instead of a race on one output file
+    vector<unique_ptr<BatchEntry>> entries;
+    map<string, string> reportOwners; // output path -> input writing it
+    size_t failedInputs = 0;
+    for (const auto& inputPath : inputFiles){
+        string outputPath = (fs::path(outputDirectory) / fs::path(inputPath).filename()).lexically_normal().string();
+        auto owner = reportOwners.emplace(outputPath, inputPath);
+        if (!owner.second){
+            cerr << "batch: " << inputPath << ": report " << outputPath << " is already written for "
+                 << owner.first->second << ", skipped\n";
+            ++failedInputs;
+            continue;
+        }
+        auto entry = make_unique<BatchEntry>();
+        entry->inputPath = inputPath;
+        entry->outputPath = move(outputPath);
+        entry->results.resize(schemes.size());
+        entry->errors.resize(schemes.size());
+        entry->remaining = static_cast<int>(schemes.size());
+        entries.push_back(move(entry));
+    }
+
+    atomic<size_t> failures{failedInputs};
+    {
+        WorkStealingPool pool(threadCount);
+        for (auto& entryPointer : entries){
+            BatchEntry* entry = entryPointer.get();
+            // Parse job: fans out one job per scheme on the same worker's deque
+            pool.submit([entry, &pool, &schemes, &options, &reportOptions, &failures]{
+                try {
+                    entry->workload = make_unique<PreparedWorkload>(parseInputFile(entry->inputPath));
+                } catch (const exception& error){
+                    cerr << "batch: " << entry->inputPath << ": " << error.what() << '\n';
+                    ++failures;
+                    return;
+                }
+                for (size_t scheme = 0; scheme < schemes.size(); ++scheme){
+                    pool.submit([entry, scheme, &schemes, &options, &reportOptions, &failures]{
+                        char algorithm = schemes[scheme];
+                        thread_local SimulationContext context;
+                        try {
+                            entry->results[scheme] = {algorithm, context.run(*entry->workload, algorithm, options)};
+                        } catch (const exception& error){
+                            entry->errors[scheme] = error.what();
+                        } catch (...){
+                            entry->errors[scheme] = "unknown error";
+                        }
+                        // Last scheme job of this file writes its report
+                        if (entry->remaining.fetch_sub(1) == 1) writeEntryReport(*entry, reportOptions, failures);
+                    });
+                }
+            });
+        }
+        pool.wait();
+    }
+
+    BatchSummary summary;
+    summary.inputs = inputFiles.size();
+    summary.jobs = entries.size() * schemes.size();
+    summary.failures = failures.load();
+    summary.wallSeconds = chrono::duration<double>(chrono::steady_clock::now() - startTime).count();
+    return summary;
+}
@@ -0,0 +1,257 @@
+#include "mlfq.h"
+#include "taskheap.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+// Scheduler benchmark: scales executeMLFQ (fresh, through a warm SimulationContext, from a PreparedWorkload,
+// and from it under a starvation policy), each strategy class and the shortest-first heap (packed keys vs
+// the former task-column comparator) over synthetic workloads; reports ns per simulated time unit and per task.
+//
+//   bench [--max=N] [--seed=S] [--arrivals=poisson|bursty] [--bursts=exp|pareto]
+//         [--interarrival=MEAN] [--burst=MEAN]
+//         [--engine=tick|event] [--accounting=tick|timestamp] [--dispatch=dynamic|static]
+//         [--boost=S] [--aging=T]   (policy of the "policy" rows; 50 and 20 by default, as --starvation-report)
+//   bench --gen=<file> [--tasks=N] [...workload flags]   (write a workload file and exit)
+
+using namespace std;
+
+namespace {
+    using Clock = chrono::steady_clock;
+
+    struct Measurement { long long simulatedUnits = 0; double seconds = 0.0; };
+
+    void printRow(const char* kind, const string& name, size_t tasks, const Measurement& m){
+        double nanoseconds = m.seconds * 1e9;
+        printf("%-9s %-7s %10zu %14lld %11.2f %10.2f %10.1f\n", kind, name.c_str(), tasks, m.simulatedUnits,
+               m.seconds * 1e3, m.simulatedUnits ? nanoseconds / m.simulatedUnits : 0.0,
+               tasks ? nanoseconds / tasks : 0.0);
+    }
+
+    Measurement benchScheme(const vector<Task>& tasks, char scheme, const SimulationOptions& options){
+        auto start = Clock::now();
+        auto result = executeMLFQ(tasks, scheme, options);
+        Measurement m;
+        m.seconds = chrono::duration<double>(Clock::now() - start).count();
+        for (const auto& task : result) m.simulatedUnits = max<long long>(m.simulatedUnits, task.finishMoment);
+        return m;
+    }
+
+    // Second run through a warm SimulationContext: no allocation, only simulation
+    Measurement benchReusedScheme(SimulationContext& context, const vector<Task>& tasks, char scheme, const SimulationOptions& options){
+        context.run(tasks, scheme, options);
+        auto start = Clock::now();
+        const auto& result = context.run(tasks, scheme, options);
+        Measurement m;
+        m.seconds = chrono::duration<double>(Clock::now() - start).count();
+        for (const auto& task : result) m.simulatedUnits = max<long long>(m.simulatedUnits, task.finishMoment);
+        return m;
+    }
+
+    // Warm context again, but from a workload interned and ordered once beforehand
+    Measurement benchPreparedScheme(SimulationContext& context, const PreparedWorkload& workload, char scheme, const SimulationOptions& options){
+        context.run(workload, scheme, options);
+        auto start = Clock::now();
+        const auto& result = context.run(workload, scheme, options);
+        Measurement m;
+        m.seconds = chrono::duration<double>(Clock::now() - start).count();
+        for (const auto& task : result) m.simulatedUnits = max<long long>(m.simulatedUnits, task.finishMoment);
+        return m;
+    }
+
+    // One strategy alone, every task queued at time 0, driven one unit at a time
+    Measurement benchStrategy(const vector<Task>& tasks, SchedulingMode mode){
+        TaskTable table(tasks);
+        auto start = Clock::now();
+        unique_ptr<SchedulingStrategy> strategy;
+        switch (mode){
+            case SchedulingMode::ROUND_ROBIN:        strategy = createRoundRobinStrategy(table, 4); break;
+            case SchedulingMode::SHORTEST_FIRST:     strategy = createShortestJobStrategy(table); break;
+            case SchedulingMode::SHORTEST_REMAINING: strategy = createPreemptiveShortestStrategy(table); break;
+        }
+        for (int taskId = 0; taskId < table.size(); ++taskId) strategy->addToQueue(taskId);
+
+        Measurement m;
+        int current = -1, completed = 0;
+        while (completed < table.size()){
+            current = strategy->selectNextTask(current);
+            --table.timeLeft[current];
+            --table.burstLeft[current];
+            ++m.simulatedUnits;
+            if (table.timeLeft[current] == 0){
+                strategy->handleTaskExit(current);
+                strategy->purgeTask(current);
+                current = -1; ++completed;
+                continue;
+            }
+            strategy->processTimeUnit(current);
+            int next = strategy->selectNextTask(current);
+            if (next != current){
+                strategy->handleTaskExit(current);
+                strategy->purgeTask(current);
+                strategy->addToQueue(current);
+                current = next;
+            }
+        }
+        m.seconds = chrono::duration<double>(Clock::now() - start).count();
+        return m;
+    }
+
+    // IndexedTaskHeap as it was before keys were packed into the entries: every
+    // comparison reads (burstLeft, arrivalMoment, identifierRank) from the table
+    class ColumnTaskHeap {
+        const TaskTable& tasks;
+        vector<int> heap, slot;
+        vector<unsigned long long> order;
+        unsigned long long insertions = 0;
+
+        bool before(int a, int b) const {
+            if (tasks.precedes(a, b)) return true;
+            if (tasks.precedes(b, a)) return false;
+            return order[a] < order[b];
+        }
+        void place(int position, int taskId) { heap[position] = taskId; slot[taskId] = position; }
+        void siftUp(int position) {
+            int taskId = heap[position];
+            while (position > 0) {
+                int parent = (position - 1) / 2;
+                if (!before(taskId, heap[parent])) break;
+                place(position, heap[parent]);
+                position = parent;
+            }
+            place(position, taskId);
+        }
+        void siftDown(int position) {
+            int taskId = heap[position], count = static_cast<int>(heap.size());
+            while (true) {
+                int child = 2 * position + 1;
+                if (child >= count) break;
+                if (child + 1 < count && before(heap[child + 1], heap[child])) ++child;
+                if (!before(heap[child], taskId)) break;
+                place(position, heap[child]);
+                position = child;
+            }
+            place(position, taskId);
+        }
+
+    public:
+        explicit ColumnTaskHeap(const TaskTable& allTasks) : tasks(allTasks) {}
+        void reset() { heap.clear(); slot.assign(tasks.size(), -1); order.assign(tasks.size(), 0); insertions = 0; }
+        bool empty() const { return heap.empty(); }
+        void push(int taskId) {
+            order[taskId] = insertions++;
+            heap.push_back(taskId);
+            siftUp(static_cast<int>(heap.size()) - 1);
+        }
+        int pop() {
+            int taskId = heap.front(), last = heap.back();
+            slot[taskId] = -1;
+            heap.pop_back();
+            if (!heap.empty()) { place(0, last); siftDown(0); }
+            return taskId;
+        }
+    };
+
+    // Selection path alone: every task queued at time 0, then pop the shortest, run it
+    // for up to 4 units and requeue it until all finish (same pops for either heap)
+    template <class Heap>
+    Measurement benchHeap(const vector<Task>& tasks){
+        TaskTable table(tasks);
+        Heap heap(table);
+        heap.reset();
+        auto start = Clock::now();
+        for (int taskId = 0; taskId < table.size(); ++taskId) heap.push(taskId);
+        Measurement m;
+        while (!heap.empty()){
+            int taskId = heap.pop();
+            int units = min(4, table.timeLeft[taskId]);
+            table.timeLeft[taskId] -= units;
+            table.burstLeft[taskId] -= min(units, table.burstLeft[taskId]);
+            m.simulatedUnits += units;
+            if (table.timeLeft[taskId] > 0) heap.push(taskId);
+        }
+        m.seconds = chrono::duration<double>(Clock::now() - start).count();
+        return m;
+    }
+}
+
+int main(int argc, char** argv){
+    WorkloadSpec spec;
+    SimulationOptions options;
+    options.engine = EngineMode::EVENT;
+    options.waitAccounting = WaitAccounting::TIMESTAMP;
+    size_t maxTasks = 100000;
+    string generatePath;
+    StarvationPolicy policy = DEFAULT_STARVATION_POLICY;
+
+    auto hasPrefix = [](const string& text, const char* prefix){
+        return text.compare(0, strlen(prefix), prefix) == 0;
+    };
+    for (int argIndex = 1; argIndex < argc; ++argIndex){
+        string argument = argv[argIndex];
+        string value = argument.substr(argument.find('=') + 1);
+        if (hasPrefix(argument, "--max=")) maxTasks = strtoull(value.c_str(), nullptr, 10);
+        else if (hasPrefix(argument, "--tasks=")) spec.taskCount = strtoull(value.c_str(), nullptr, 10);
+        else if (hasPrefix(argument, "--seed=")) spec.seed = strtoull(value.c_str(), nullptr, 10);
+        else if (hasPrefix(argument, "--gen=")) generatePath = value;
+        else if (hasPrefix(argument, "--interarrival=")) spec.meanInterarrival = strtod(value.c_str(), nullptr);
+        else if (hasPrefix(argument, "--burst=")) spec.meanBurst = strtod(value.c_str(), nullptr);
+        else if (argument == "--arrivals=poisson") spec.arrivals = ArrivalPattern::POISSON;
+        else if (argument == "--arrivals=bursty") spec.arrivals = ArrivalPattern::BURSTY;
+        else if (argument == "--bursts=exp") spec.bursts = BurstDistribution::EXPONENTIAL;
+        else if (argument == "--bursts=pareto") spec.bursts = BurstDistribution::PARETO;
+        else if (argument == "--engine=tick") options.engine = EngineMode::TICK;
+        else if (argument == "--engine=event") options.engine = EngineMode::EVENT;
+        else if (argument == "--accounting=tick") options.waitAccounting = WaitAccounting::PER_TICK;
+        else if (argument == "--accounting=timestamp") options.waitAccounting = WaitAccounting::TIMESTAMP;
+        else if (argument == "--dispatch=dynamic") options.dispatch = DispatchMode::DYNAMIC;
+        else if (argument == "--dispatch=static") options.dispatch = DispatchMode::STATIC;
+        else if (hasPrefix(argument, "--boost=")) policy.boostInterval = atoi(value.c_str());
+        else if (hasPrefix(argument, "--aging=")) policy.agingThreshold = atoi(value.c_str());
+        else { cerr << "unknown argument: " << argument << '\n'; return 1; }
+    }
+
+    if (!generatePath.empty()){
+        ofstream output(generatePath, ios::binary);
+        if (!output) return 2;
+        writeTaskFile(output, generateWorkload(spec));
+        return 0;
+    }
+
+    printf("# arrivals=%s bursts=%s seed=%llu engine=%s accounting=%s dispatch=%s policy=%s\n",
+           spec.arrivals == ArrivalPattern::POISSON ? "poisson" : "bursty",
+           spec.bursts == BurstDistribution::EXPONENTIAL ? "exp" : "pareto", spec.seed,
+           options.engine == EngineMode::EVENT ? "event" : "tick",
+           options.waitAccounting == WaitAccounting::TIMESTAMP ? "timestamp" : "tick",
+           options.dispatch == DispatchMode::STATIC ? "static" : "dynamic", describePolicy(policy).c_str());
+    printf("%-9s %-7s %10s %14s %11s %10s %10s\n", "kind", "name", "tasks", "sim_units", "wall_ms", "ns/unit", "ns/task");
+
+    SimulationOptions policyOptions = options;
+    policyOptions.starvation = policy;
+    SimulationContext context;
+    for (size_t taskCount = 10; taskCount <= maxTasks; taskCount *= 10){
+        spec.taskCount = taskCount;
+        auto tasks = generateWorkload(spec);
+        for (char scheme : {'A', 'B', 'C'})
+            printRow("scheme", string(1, scheme), taskCount, benchScheme(tasks, scheme, options));
+        for (char scheme : {'A', 'B', 'C'})
+            printRow("reused", string(1, scheme), taskCount, benchReusedScheme(context, tasks, scheme, options));
+        const PreparedWorkload prepared(tasks);
+        for (char scheme : {'A', 'B', 'C'})
+            printRow("prepared", string(1, scheme), taskCount, benchPreparedScheme(context, prepared, scheme, options));
+        for (char scheme : {'A', 'B', 'C'})
+            printRow("policy", string(1, scheme), taskCount, benchPreparedScheme(context, prepared, scheme, policyOptions));
+        printRow("strategy", "RR(4)", taskCount, benchStrategy(tasks, SchedulingMode::ROUND_ROBIN));
+        printRow("strategy", "SJF", taskCount, benchStrategy(tasks, SchedulingMode::SHORTEST_FIRST));
+        printRow("strategy", "STCF", taskCount, benchStrategy(tasks, SchedulingMode::SHORTEST_REMAINING));
+        printRow("heap", "packed", taskCount, benchHeap<IndexedTaskHeap>(tasks));
+        printRow("heap", "columns", taskCount, benchHeap<ColumnTaskHeap>(tasks));
+        fflush(stdout);
+    }
+    return 0;
+}
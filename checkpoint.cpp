@@ -0,0 +1,306 @@
+#include "mlfq.h"
+#include "engine.h"
+#include "levels.h"
+#include "pipeline.h"
+#include <algorithm>
+#include <cctype>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+
+using namespace std;
+
+// Checkpointed simulation: periodic snapshots, what-if replays from the nearest one, snapshot files
+
+namespace {
+    // File layout (host byte order, like trace files):
+    //   magic "MLFQCKP2", uint64 input fingerprint, uint32 task count, uint8 wait accounting,
+    //   int32 boost interval, int32 aging threshold, uint32 scheme length + scheme spec,
+    //   int32 interval, uint32 snapshot count,
+    //   then per snapshot: int32 time, uint64 word count, int32 words[]
+    const char CHECKPOINT_MAGIC[8] = {'M', 'L', 'F', 'Q', 'C', 'K', 'P', '2'};
+
+    struct Snapshot {
+        int time = 0;
+        SavedState state;
+    };
+
+    bool sameInput(const Task& a, const Task& b){
+        return a.identifier == b.identifier && a.serviceDuration == b.serviceDuration
+            && a.arrivalMoment == b.arrivalMoment && a.bursts == b.bursts;
+    }
+
+    bool sameIdentifiers(const vector<Task>& a, const vector<Task>& b){
+        for (size_t i = 0; i < a.size(); ++i)
+            if (a[i].identifier != b[i].identifier) return false;
+        return true;
+    }
+
+    // A task can only influence the schedule from the moment it arrives, so two inputs
+    // run identically before the earliest arrival (old or new) of any task that differs
+    int firstAffectedTime(const vector<Task>& baseline, const vector<Task>& modified){
+        int earliest = CheckpointedSimulation::NO_LIMIT;
+        for (size_t i = 0; i < baseline.size(); ++i)
+            if (!sameInput(baseline[i], modified[i]))
+                earliest = min({earliest, baseline[i].arrivalMoment, modified[i].arrivalMoment});
+        return earliest;
+    }
+
+    // About 32 snapshots before the last task can finish: the last arrival, then every CPU and I/O unit in a row
+    int defaultInterval(const vector<Task>& tasks){
+        long long horizon = 0, work = 0;
+        for (const auto& task : tasks){
+            horizon = max(horizon, static_cast<long long>(task.arrivalMoment));
+            work += task.serviceDuration;
+            for (size_t i = 1; i < task.bursts.size(); i += 2) work += task.bursts[i];
+        }
+        horizon += work;
+        return static_cast<int>(min<long long>(INT_MAX, max(1LL, horizon / 32)));
+    }
+
+    // FNV-1a over the fields the simulation reads
+    uint64_t fingerprint(const vector<Task>& tasks){
+        uint64_t hash = 1469598103934665603ULL;
+        auto mix = [&](const void* data, size_t length){
+            const unsigned char* bytes = static_cast<const unsigned char*>(data);
+            for (size_t i = 0; i < length; ++i) { hash ^= bytes[i]; hash *= 1099511628211ULL; }
+        };
+        for (const auto& task : tasks){
+            uint32_t length = static_cast<uint32_t>(task.identifier.size());
+            mix(&length, sizeof(length));
+            mix(task.identifier.data(), task.identifier.size());
+            mix(&task.serviceDuration, sizeof(task.serviceDuration));
+            mix(&task.arrivalMoment, sizeof(task.arrivalMoment));
+            mix(task.bursts.data(), task.bursts.size() * sizeof(int));
+            length = static_cast<uint32_t>(task.bursts.size());
+            mix(&length, sizeof(length));
+        }
+        return hash;
+    }
+
+    template <class Value>
+    void writeValue(ostream& output, const Value& value){
+        output.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    template <class Value>
+    Value readValue(istream& input){
+        Value value{};
+        if (!input.read(reinterpret_cast<char*>(&value), sizeof(value))) throw runtime_error("❌ Checkpoint file is truncated.");
+        return value;
+    }
+}
+
+int StateReader::next(){
+    if (position == words.size()) throw runtime_error("❌ Checkpoint state is truncated.");
+    return words[position++];
+}
+
+long long StateReader::nextWide(){
+    unsigned long long high = static_cast<unsigned int>(next());
+    unsigned long long low = static_cast<unsigned int>(next());
+    return static_cast<long long>(high << 32 | low);
+}
+
+struct CheckpointedSimulation::State {
+    char algorithm;
+    SimulationOptions options;
+    int requestedInterval, interval = 1;
+    vector<Task> baseline;
+    vector<int> baselineRanks;   // interned identifiers, reused by what-ifs that keep them
+    vector<Snapshot> snapshots;  // baseline only, ascending time
+
+    TaskTable table;
+    EngineScratch scratch;
+    vector<Task> results;
+    unique_ptr<DynamicLevels> dynamicLevels;
+    unique_ptr<PipelineA> pipelineA;
+    unique_ptr<PipelineB> pipelineB;
+    unique_ptr<PipelineC> pipelineC;
+    bool complete = false;
+    int stopTime = 0, startTime = 0;
+
+    State(char scheme, const SimulationOptions& simulationOptions, int snapshotInterval)
+        : algorithm(scheme), options(simulationOptions), requestedInterval(snapshotInterval) {
+        if (snapshotInterval < 0) throw invalid_argument("❌ Checkpoint interval must not be negative.");
+        defineAlgorithmScheme(algorithm); // unknown schemes fail here rather than on the first run
+    }
+
+    // Simulate 'input' from 'from' (nullptr: time 0) until every task completes or a step ends
+    // at or after 'until'; a baseline run ('record') snapshots on the way and where it stops
+    const vector<Task>& simulate(const vector<Task>& input, const Snapshot* from, int until, bool record){
+        // Interning sorts every identifier: what-ifs that keep them all reuse the baseline's ranks
+        if (sameIdentifiers(input, baseline)){
+            if (baselineRanks.size() != baseline.size()) baselineRanks = internIdentifiers(baseline);
+            table.load(input, baselineRanks);
+        } else {
+            table.load(input);
+        }
+        if (options.dispatch == DispatchMode::STATIC && hasStaticPipeline(algorithm)){
+            switch (toupper(algorithm)){
+                case 'A': replay(pipeline(pipelineA), from, until, record); break;
+                case 'B': replay(pipeline(pipelineB), from, until, record); break;
+                case 'C': replay(pipeline(pipelineC), from, until, record); break;
+            }
+        } else {
+            if (!dynamicLevels) dynamicLevels = make_unique<DynamicLevels>(defineAlgorithmScheme(algorithm), table);
+            replay(*dynamicLevels, from, until, record);
+        }
+        table.toTasks(results);
+        return results;
+    }
+
+    template <class Levels>
+    Levels& pipeline(unique_ptr<Levels>& levels){
+        if (!levels) levels = make_unique<Levels>(table);
+        return *levels;
+    }
+
+    template <class Levels>
+    void replay(Levels& levels, const Snapshot* from, int until, bool record){
+        levels.reset();
+        MLFQCore<Levels> cpu(table, levels, options, &scratch);
+        arrivalOrder(table, scratch.arrivalSequence);
+        const vector<int>& arrivalSequence = scratch.arrivalSequence;
+
+        int currentTime = 0;
+        if (from){
+            StateReader reader(from->state);
+            table.restoreRunState(reader);
+            cpu.restoreState(reader, from->time);
+            if (!reader.exhausted()) throw runtime_error("❌ Checkpoint does not match the scheme.");
+            currentTime = from->time;
+        }
+        // Everything that arrived before the snapshot is already in it
+        size_t nextArrivalIndex = lower_bound(arrivalSequence.begin(), arrivalSequence.end(), currentTime,
+            [&](int taskId, int time){ return table.arrivalMoment[taskId] < time; }) - arrivalSequence.begin();
+        startTime = currentTime;
+
+        auto takeSnapshot = [&]{
+            snapshots.emplace_back();
+            snapshots.back().time = currentTime;
+            table.saveRunState(snapshots.back().state, currentTime);
+            cpu.saveState(snapshots.back().state);
+        };
+
+        auto after = [&](int time){ return time > NO_LIMIT - interval ? NO_LIMIT : time + interval; };
+        int nextSnapshot = record ? after(currentTime) : NO_LIMIT;
+        while (cpu.completedTasks() < table.size() && currentTime < until){
+            if (currentTime >= nextSnapshot){
+                takeSnapshot();
+                nextSnapshot = after(currentTime);
+            }
+            while (nextArrivalIndex < arrivalSequence.size() && table.arrivalMoment[arrivalSequence[nextArrivalIndex]] == currentTime){
+                cpu.admit(arrivalSequence[nextArrivalIndex], currentTime);
+                ++nextArrivalIndex;
+            }
+            int horizon = nextArrivalIndex < arrivalSequence.size()
+                ? table.arrivalMoment[arrivalSequence[nextArrivalIndex]] : MLFQCore<Levels>::NO_HORIZON;
+            currentTime += cpu.advance(currentTime, horizon);
+        }
+        complete = cpu.completedTasks() == table.size();
+        stopTime = currentTime;
+        // A stopped baseline resumes from exactly where it stopped
+        if (record && !complete && (snapshots.empty() || snapshots.back().time != currentTime)) takeSnapshot();
+    }
+
+    const Snapshot* latestSnapshot(int time) const {
+        auto after = upper_bound(snapshots.begin(), snapshots.end(), time,
+                                 [](int moment, const Snapshot& snapshot){ return moment < snapshot.time; });
+        return after == snapshots.begin() ? nullptr : &*prev(after);
+    }
+};
+
+CheckpointedSimulation::CheckpointedSimulation(char algorithm, const SimulationOptions& options, int interval)
+    : state(make_unique<State>(algorithm, options, interval)) {}
+
+CheckpointedSimulation::~CheckpointedSimulation() = default;
+
+const vector<Task>& CheckpointedSimulation::run(const vector<Task>& input, int until){
+    State& s = *state;
+    s.baseline = input;
+    s.baselineRanks.clear();
+    s.snapshots.clear();
+    s.interval = s.requestedInterval ? s.requestedInterval : defaultInterval(input);
+    return s.simulate(s.baseline, nullptr, until, true);
+}
+
+const vector<Task>& CheckpointedSimulation::resume(int until){
+    State& s = *state;
+    return s.simulate(s.baseline, s.snapshots.empty() ? nullptr : &s.snapshots.back(), until, true);
+}
+
+const vector<Task>& CheckpointedSimulation::whatIf(const vector<Task>& modified){
+    State& s = *state;
+    if (modified.size() != s.baseline.size())
+        throw invalid_argument("❌ What-if input must keep the baseline's " + to_string(s.baseline.size()) + " tasks.");
+    return s.simulate(modified, s.latestSnapshot(firstAffectedTime(s.baseline, modified)), NO_LIMIT, false);
+}
+
+bool CheckpointedSimulation::finished() const { return state->complete; }
+int CheckpointedSimulation::now() const { return state->stopTime; }
+int CheckpointedSimulation::resumedFrom() const { return state->startTime; }
+size_t CheckpointedSimulation::checkpoints() const { return state->snapshots.size(); }
+
+void CheckpointedSimulation::save(ostream& output) const {
+    const State& s = *state;
+    const string scheme = formatSchemeSpec(defineAlgorithmScheme(s.algorithm));
+    output.write(CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC));
+    writeValue(output, fingerprint(s.baseline));
+    writeValue(output, static_cast<uint32_t>(s.baseline.size()));
+    writeValue(output, static_cast<uint8_t>(s.options.waitAccounting == WaitAccounting::TIMESTAMP));
+    writeValue(output, static_cast<int32_t>(s.options.starvation.boostInterval));
+    writeValue(output, static_cast<int32_t>(s.options.starvation.agingThreshold));
+    writeValue(output, static_cast<uint32_t>(scheme.size()));
+    output.write(scheme.data(), static_cast<streamsize>(scheme.size()));
+    writeValue(output, static_cast<int32_t>(s.interval));
+    writeValue(output, static_cast<uint32_t>(s.snapshots.size()));
+    for (const auto& snapshot : s.snapshots){
+        writeValue(output, static_cast<int32_t>(snapshot.time));
+        writeValue(output, static_cast<uint64_t>(snapshot.state.words.size()));
+        output.write(reinterpret_cast<const char*>(snapshot.state.words.data()),
+                     static_cast<streamsize>(snapshot.state.words.size() * sizeof(int)));
+    }
+    if (!output) throw runtime_error("❌ Unable to write checkpoints.");
+}
+
+void CheckpointedSimulation::load(const vector<Task>& input, istream& source){
+    State& s = *state;
+    char magic[sizeof(CHECKPOINT_MAGIC)];
+    if (!source.read(magic, sizeof(magic)) || memcmp(magic, CHECKPOINT_MAGIC, sizeof(magic)) != 0)
+        throw runtime_error("❌ Not a checkpoint file.");
+    const uint64_t inputFingerprint = readValue<uint64_t>(source);
+    const uint32_t taskCount = readValue<uint32_t>(source);
+    if (inputFingerprint != fingerprint(input) || taskCount != input.size())
+        throw runtime_error("❌ Checkpoints belong to another input.");
+    const bool timestampAccounting = readValue<uint8_t>(source) != 0;
+    const int boostInterval = readValue<int32_t>(source);
+    const int agingThreshold = readValue<int32_t>(source);
+    string scheme(readValue<uint32_t>(source), '\0');
+    if (!source.read(&scheme[0], static_cast<streamsize>(scheme.size()))) throw runtime_error("❌ Checkpoint file is truncated.");
+    // Waiting time is mid-flight in the snapshots, so the accounting mode has to match too
+    if (scheme != formatSchemeSpec(defineAlgorithmScheme(s.algorithm))
+        || timestampAccounting != (s.options.waitAccounting == WaitAccounting::TIMESTAMP))
+        throw runtime_error("❌ Checkpoints belong to another scheme: " + scheme);
+    if (boostInterval != s.options.starvation.boostInterval || agingThreshold != s.options.starvation.agingThreshold)
+        throw runtime_error("❌ Checkpoints were taken under another starvation policy.");
+
+    const int interval = readValue<int32_t>(source);
+    vector<Snapshot> snapshots(readValue<uint32_t>(source));
+    for (auto& snapshot : snapshots){
+        snapshot.time = readValue<int32_t>(source);
+        snapshot.state.words.resize(readValue<uint64_t>(source));
+        if (!source.read(reinterpret_cast<char*>(snapshot.state.words.data()),
+                         static_cast<streamsize>(snapshot.state.words.size() * sizeof(int))))
+            throw runtime_error("❌ Checkpoint file is truncated.");
+    }
+    s.baseline = input;
+    s.baselineRanks.clear();
+    s.snapshots = move(snapshots);
+    s.interval = max(1, interval);
+    s.complete = false;
+    s.stopTime = s.startTime = s.snapshots.empty() ? 0 : s.snapshots.back().time;
+}
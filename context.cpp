@@ -0,0 +1,88 @@
+#include "mlfq.h"
+#include "engine.h"
+#include "levels.h"
+#include "pipeline.h"
+#include <cctype>
+
+using namespace std;
+
+// Reusable simulation context: one task table and one set of levels per scheme, reset per run,
+// and the prepared workloads runs can start from
+
+namespace {
+    bool sameScheme(const LevelScheme& a, const LevelScheme& b){
+        if (a.size() != b.size()) return false;
+        for (size_t level = 0; level < a.size(); ++level)
+            if (a[level].strategy != b[level].strategy || a[level].timeSlice != b[level].timeSlice) return false;
+        return true;
+    }
+}
+
+struct SimulationContext::State {
+    TaskTable table;
+    vector<Task> results;
+    EngineScratch scratch;
+    // Strategies hold a reference to 'table', so they are built once and reset per run
+    vector<pair<LevelScheme, unique_ptr<DynamicLevels>>> dynamicLevels;
+    unique_ptr<PipelineA> pipelineA;
+    unique_ptr<PipelineB> pipelineB;
+    unique_ptr<PipelineC> pipelineC;
+
+    DynamicLevels& levelsFor(char algorithm){
+        const LevelScheme& scheme = defineAlgorithmScheme(algorithm);
+        for (auto& entry : dynamicLevels)
+            if (sameScheme(entry.first, scheme)) return *entry.second;
+        dynamicLevels.emplace_back(scheme, make_unique<DynamicLevels>(scheme, table));
+        return *dynamicLevels.back().second;
+    }
+
+    template <class Levels>
+    void simulate(unique_ptr<Levels>& levels, const SimulationOptions& options, const vector<int>* arrivals){
+        if (!levels) levels = make_unique<Levels>(table);
+        simulate(*levels, options, arrivals);
+    }
+
+    // 'arrivals' null: sort the table's arrivals for this run
+    template <class Levels>
+    void simulate(Levels& levels, const SimulationOptions& options, const vector<int>* arrivals){
+        levels.reset();
+        if (arrivals) simulateMLFQ(table, levels, options, scratch, *arrivals);
+        else simulateMLFQ(table, levels, options, scratch);
+    }
+
+    void simulate(char algorithm, const SimulationOptions& options, const vector<int>* arrivals){
+        if (options.dispatch == DispatchMode::STATIC && hasStaticPipeline(algorithm)){
+            switch (toupper(algorithm)){
+                case 'A': simulate(pipelineA, options, arrivals); break;
+                case 'B': simulate(pipelineB, options, arrivals); break;
+                case 'C': simulate(pipelineC, options, arrivals); break;
+            }
+        } else {
+            simulate(levelsFor(algorithm), options, arrivals);
+        }
+        table.toTasks(results);
+    }
+};
+
+PreparedWorkload::PreparedWorkload(vector<Task> tasks) : records(move(tasks)) {
+    table.load(records, internIdentifiers(records));
+    arrivalOrder(table, arrivals);
+}
+
+SimulationContext::SimulationContext() : state(make_unique<State>()) {}
+
+SimulationContext::~SimulationContext() = default;
+
+const vector<Task>& SimulationContext::run(const vector<Task>& input, char algorithm, const SimulationOptions& options){
+    State& s = *state;
+    s.table.load(input);
+    s.simulate(algorithm, options, nullptr);
+    return s.results;
+}
+
+const vector<Task>& SimulationContext::run(const PreparedWorkload& workload, char algorithm, const SimulationOptions& options){
+    State& s = *state;
+    s.table.load(workload);
+    s.simulate(algorithm, options, &workload.arrivalSequence());
+    return s.results;
+}
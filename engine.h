@@ -0,0 +1,486 @@
+#pragma once
+#include "mlfq.h"
+#include "trace.h"
+#include <algorithm>
+#include <climits>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+// =============================================================
+// MLFQ engine shared by every level container
+// =============================================================
+//
+// 'Levels' is either the runtime-configured array of strategies (virtual
+// dispatch, mlfq.cpp) or a compile-time pipeline (pipeline.h). It provides:
+//   depth() (1..MAX_LEVELS) and firstReadyLevel() (lowest non-empty level index, -1: none);
+//   per level index: hasWork, queueLength, addToQueue, selectNextTask, peekNextTask,
+//     processTimeUnit, processTimeUnits, runBudget, handleTaskExit, purgeTask;
+//   across all levels: updateWaitingTimes, accumulateWaitingTimes,
+//     enableTimestampAccounting, reset, refreshRank, saveState, restoreState.
+
+// Statistics hooks: a null check when disabled at runtime, nothing at all with -DMLFQ_NO_STATS
+#if defined(MLFQ_NO_STATS)
+#  define MLFQ_STAT(statement) ((void)0)
+#else
+#  define MLFQ_STAT(statement) do { if (statistics) { statement; } } while (0)
+#endif
+
+// Trace hooks run on context switches only; compiled out with -DMLFQ_NO_TRACE
+#if defined(MLFQ_NO_TRACE)
+#  define MLFQ_TRACE(statement) ((void)0)
+#else
+#  define MLFQ_TRACE(statement) do { if (trace) { trace->statement; } } while (0)
+#endif
+
+// Histogram bucket for a queue length: 0, 1, 2-3, 4-7, ...
+inline int queueLengthBucket(int length){
+    int bucket = 0;
+    while (length > 0) { ++bucket; length >>= 1; }
+    return bucket;
+}
+
+// Stable arrival ordering by (arrivalMoment, identifier): full ties keep input order,
+// the order a streaming reader sees them in. The task ID is the last key, so a plain
+// sort is stable and needs no temporary buffer.
+inline void arrivalOrder(const TaskTable& taskTable, std::vector<int>& arrivalSequence){
+    arrivalSequence.resize(taskTable.size());
+    std::iota(arrivalSequence.begin(), arrivalSequence.end(), 0);
+    std::sort(arrivalSequence.begin(), arrivalSequence.end(), [&](int x, int y){
+        if (taskTable.arrivalMoment[x] != taskTable.arrivalMoment[y]) return taskTable.arrivalMoment[x] < taskTable.arrivalMoment[y];
+        if (taskTable.identifierRank[x] != taskTable.identifierRank[y]) return taskTable.identifierRank[x] < taskTable.identifierRank[y];
+        return x < y;
+    });
+}
+
+inline std::vector<int> arrivalOrder(const TaskTable& taskTable){
+    std::vector<int> arrivalSequence;
+    arrivalOrder(taskTable, arrivalSequence);
+    return arrivalSequence;
+}
+
+// Ready tasks below the top level in the order they entered their queue, for aging:
+// an intrusive list over task IDs plus each one's entry time. Entry times never
+// decrease, so the front always holds the next aging deadline and no queue is
+// scanned per tick; a dispatched or moved task is unlinked in O(1).
+class AgingList {
+public:
+    void clear() { next.clear(); previous.clear(); since.clear(); head = tail = -1; count = 0; } // keeps capacity
+    int  front() const { return head; }
+    int  size() const { return count; }
+    int  enteredAt(int taskId) const { return since[taskId]; }
+    bool contains(int taskId) const {
+        return taskId < static_cast<int>(next.size()) && next[taskId] != UNLINKED;
+    }
+
+    // 'capacity': task count to size the list for on first use
+    void pushBack(int taskId, int time, int capacity) {
+        if (taskId >= static_cast<int>(next.size())) {
+            int size = std::max(capacity, taskId + 1);
+            next.resize(size, UNLINKED);
+            previous.resize(size, -1);
+            since.resize(size, -1);
+        }
+        previous[taskId] = tail;
+        next[taskId] = -1;
+        since[taskId] = time;
+        if (tail != -1) next[tail] = taskId; else head = taskId;
+        tail = taskId;
+        ++count;
+    }
+
+    void remove(int taskId) {
+        if (!contains(taskId)) return;
+        int before = previous[taskId], after = next[taskId];
+        if (before != -1) next[before] = after; else head = after;
+        if (after != -1) previous[after] = before; else tail = before;
+        next[taskId] = UNLINKED;
+        --count;
+    }
+
+    template <class Action>
+    void forEach(Action action) const {
+        for (int taskId = head; taskId != -1; taskId = next[taskId]) action(taskId);
+    }
+
+private:
+    static constexpr int UNLINKED = -2;
+    std::vector<int> next, previous, since;
+    int head = -1, tail = -1, count = 0;
+};
+
+// Engine buffers a caller can keep from run to run (SimulationContext)
+struct EngineScratch {
+    std::vector<int> arrivalSequence;
+    std::vector<std::pair<int,int>> blocked;  // (wake-up time, task) heap of MLFQCore
+    AgingList aging;                          // MLFQCore's aging order (agingThreshold > 0)
+};
+
+// Bitmap lookup in the containers: O(1) at any depth
+template <class Levels>
+int locateHighestPriorityLevel(const Levels& levels){
+    return levels.firstReadyLevel();
+}
+
+// One CPU worth of MLFQ state: the running task and its level, plus the tick
+// rules (preemption, selection, execution, completion and level movement).
+// The caller owns the clock and delivers arrivals through admit(); advance()
+// simulates from a given time and reports how many units it consumed.
+// Tasks whose CPU burst ends before their last one wait here, ordered by wake-up
+// time, and re-enter at their current tier once the I/O is over (behind the
+// arrivals of that same instant).
+// With a StarvationPolicy, a periodic boost sends every task back to the top level
+// and aging lifts a task one level after waiting agingThreshold units in a queue;
+// both are events the event engine stops at, like arrivals and wake-ups.
+template <class Levels>
+class MLFQCore {
+public:
+    static constexpr int NO_HORIZON = INT_MAX; // advance(): no external event pending
+
+    // 'scratch': caller-kept buffers for the blocked heap and the aging list (cleared here), or nullptr
+    MLFQCore(TaskTable& table, Levels& schedulingLevels, const SimulationOptions& options,
+             EngineScratch* scratch = nullptr)
+        : taskTable(table), levels(schedulingLevels),
+          eventDriven(options.engine == EngineMode::EVENT),
+          perTickWaiting(options.waitAccounting == WaitAccounting::PER_TICK),
+          statistics(options.statistics), trace(options.trace), starvation(options.starvation),
+          nextBoost(options.starvation.boostInterval > 0 ? options.starvation.boostInterval : NO_HORIZON),
+          blocked(scratch ? scratch->blocked : ownScratch.blocked),
+          aging(scratch ? scratch->aging : ownScratch.aging), wakesLater{&table} {
+        blocked.clear();
+        aging.clear();
+        // Timestamp accounting: queue changes made after a unit executes count from the next unit
+        if (!perTickWaiting) levels.enableTimestampAccounting(&accountingClock);
+        MLFQ_STAT(if (statistics->levels.size() < static_cast<size_t>(levels.depth())) statistics->levels.resize(levels.depth()));
+    }
+
+    MLFQCore(const MLFQCore&) = delete;            // the levels keep a pointer to accountingClock
+    MLFQCore& operator=(const MLFQCore&) = delete;
+
+    int  completedTasks() const { return completed; }
+    int  nextWakeUp() const { return blocked.empty() ? NO_HORIZON : blocked.front().first; } // earliest I/O completion
+    int  lastCompletedTask() const { return justCompleted; } // task finished by the last advance() (-1: none)
+    long long busyUnits() const { return executedUnits; }
+    bool idle() const { return activeTaskId == -1 && locateHighestPriorityLevel(levels) == -1; }
+
+    // Ready tasks across all levels (the running task excluded)
+    int queuedTasks() const {
+        int total = 0;
+        for (int i = 0; i < levels.depth(); ++i) total += levels.queueLength(i);
+        return total;
+    }
+    int load() const { return queuedTasks() + (activeTaskId != -1 ? 1 : 0); }
+
+    // Task becomes ready at 'now' on the level given by its tier
+    void admit(int taskId, int now) {
+        accountingClock = now;
+        assignToLevel(taskId);
+    }
+
+    // Remove the next candidate of the lowest-priority non-empty level (work stealing).
+    // Returns -1 when no level can give one up.
+    int surrender(int now) {
+        accountingClock = now;
+        for (int level = levels.depth() - 1; level >= 0; --level){
+            if (!levels.hasWork(level)) continue;
+            int taskId = levels.peekNextTask(level);
+            if (taskId == -1) continue;
+            levels.purgeTask(level, taskId);
+            aging.remove(taskId);
+            return taskId;
+        }
+        return -1;
+    }
+
+    // Checkpoints: running task, counters, blocked tasks, the starvation policy's
+    // progress and every level's state (the task table is saved separately). Restore
+    // into a freshly constructed core over reset levels; the running task's trace
+    // segment reopens at 'now'.
+    void saveState(SavedState& state) const {
+        state.put(activeTaskId);
+        state.put(activeLevel);
+        state.put(completed);
+        state.putWide(executedUnits);
+        state.put(static_cast<int>(blocked.size()));
+        for (const auto& entry : blocked) { state.put(entry.first); state.put(entry.second); }
+        state.put(nextBoost);
+        state.put(aging.size());
+        aging.forEach([&](int taskId){ state.put(taskId); state.put(aging.enteredAt(taskId)); });
+        levels.saveState(state);
+    }
+
+    void restoreState(StateReader& state, int now) {
+        activeTaskId = state.next();
+        activeLevel = state.next();
+        completed = state.next();
+        executedUnits = state.nextWide();
+        blocked.clear();
+        for (int count = state.next(); count > 0; --count){
+            int wakeUp = state.next();
+            blocked.emplace_back(wakeUp, state.next());
+        }
+        nextBoost = state.next();
+        aging.clear();
+        for (int count = state.next(); count > 0; --count){
+            int taskId = state.next();
+            aging.pushBack(taskId, state.next(), taskTable.size());
+        }
+        levels.restoreState(state);
+        if (activeTaskId != -1) MLFQ_TRACE(begin(activeTaskId, activeLevel, now));
+        (void)now;
+    }
+
+    // Simulate from 'now' with the arrivals due at 'now' already admitted: one unit,
+    // or with the event engine a quiet stretch that ends no later than 'horizon'
+    // (the next external event). Returns the units consumed (at least 1).
+    int advance(int now, int horizon) {
+        accountingClock = now;
+        justCompleted = -1;
+        if (now >= nextBoost) boostAll(now);
+        while (!blocked.empty() && blocked.front().first <= now){
+            std::pop_heap(blocked.begin(), blocked.end(), wakesLater);
+            assignToLevel(blocked.back().second);
+            blocked.pop_back();
+        }
+        if (starvation.agingThreshold > 0) promoteAged(now);
+        horizon = std::min({horizon, nextWakeUp(), nextBoost, nextAgingDeadline()});
+
+        // Find highest priority level with ready tasks
+        int topLevel = locateHighestPriorityLevel(levels);
+        if (topLevel == -1 && activeTaskId != -1) topLevel = activeLevel; // maintain level if already executing
+
+        if (topLevel == -1){
+            // CPU idle: the event engine jumps straight to the next external event
+            int units = (eventDriven && horizon != NO_HORIZON && horizon > now) ? horizon - now : 1;
+            if (units == 1) updateWaitingTasks(-1);
+            MLFQ_STAT(sampleQueueLengths(units));
+            return units;
+        }
+
+        // Preemption due to higher priority level appearance
+        if (activeTaskId != -1 && topLevel < activeLevel){
+            if (taskTable.timeLeft[activeTaskId] > 0){
+                // Re-queue at same level
+                enqueue(activeLevel, activeTaskId);
+            }
+            MLFQ_STAT(++statistics->levels[activeLevel].preemptions);
+            MLFQ_TRACE(end(now, TraceExit::PREEMPTED));
+            activeTaskId = -1; activeLevel = -1;
+        }
+        if (activeTaskId == -1) activeLevel = topLevel;
+
+        int selectedTask = levels.selectNextTask(activeLevel, activeTaskId);
+        if (selectedTask != activeTaskId){
+            if (activeTaskId != -1) MLFQ_TRACE(end(now, TraceExit::PREEMPTED)); // a shorter task took over
+            if (activeTaskId != -1) queuedBy(activeLevel, activeTaskId);       // the level re-queued it itself
+            if (selectedTask != -1) MLFQ_TRACE(begin(selectedTask, activeLevel, now));
+            if (selectedTask != -1) aging.remove(selectedTask);
+            activeTaskId = selectedTask;
+            if (activeTaskId != -1 && taskTable.startMoment[activeTaskId] < 0) taskTable.startMoment[activeTaskId] = now;
+            if (activeTaskId != -1) MLFQ_STAT(++statistics->levels[activeLevel].dispatches);
+        }
+
+        if (activeTaskId == -1){
+            updateWaitingTasks(-1); MLFQ_STAT(sampleQueueLengths(1)); return 1;
+        }
+
+        // Event engine: run all quiet units (no arrival, completion or switch) in one step.
+        // The last unit before the next event goes through the regular tick below.
+        if (eventDriven){
+            int quietUnits = std::min(taskTable.burstLeft[activeTaskId],
+                                      levels.runBudget(activeLevel, activeTaskId)) - 1;
+            horizon = std::min(horizon, nextAgingDeadline()); // a task preempted above may have started aging
+            if (horizon != NO_HORIZON) quietUnits = std::min(quietUnits, horizon - now);
+            if (quietUnits > 0){
+                taskTable.timeLeft[activeTaskId] -= quietUnits;
+                taskTable.burstLeft[activeTaskId] -= quietUnits;
+                if (perTickWaiting) levels.accumulateWaitingTimes(activeTaskId, quietUnits);
+                levels.processTimeUnits(activeLevel, activeTaskId, quietUnits);
+                MLFQ_STAT(sampleQueueLengths(quietUnits));
+                executedUnits += quietUnits;
+                return quietUnits;
+            }
+        }
+
+        // Execute 1 time unit
+        taskTable.timeLeft[activeTaskId]--;
+        taskTable.burstLeft[activeTaskId]--;
+        updateWaitingTasks(activeTaskId);
+        MLFQ_STAT(sampleQueueLengths(1));
+        ++executedUnits;
+        accountingClock = now + 1;
+
+        if (taskTable.timeLeft[activeTaskId] == 0){
+            // Task completed
+            taskTable.finishMoment[activeTaskId] = now + 1;
+            levels.handleTaskExit(activeLevel, activeTaskId);
+            levels.purgeTask(activeLevel, activeTaskId);
+            MLFQ_TRACE(end(now + 1, TraceExit::COMPLETED));
+            justCompleted = activeTaskId;
+            activeTaskId = -1; activeLevel = -1; ++completed;
+        } else if (taskTable.burstLeft[activeTaskId] == 0){
+            // CPU burst over: off to I/O, keeping its tier
+            levels.handleTaskExit(activeLevel, activeTaskId);
+            levels.purgeTask(activeLevel, activeTaskId);
+            MLFQ_TRACE(end(now + 1, TraceExit::BLOCKED));
+            blocked.emplace_back(now + 1 + taskTable.beginIo(activeTaskId), activeTaskId);
+            std::push_heap(blocked.begin(), blocked.end(), wakesLater);
+            activeTaskId = -1; activeLevel = -1;
+        } else {
+            // Task not finished: strategy might force context switch (e.g., RR quantum expiry)
+            const int tierBefore = taskTable.tier[activeTaskId];
+            levels.processTimeUnit(activeLevel, activeTaskId);
+            if (taskTable.tier[activeTaskId] > levels.depth()) taskTable.tier[activeTaskId] = levels.depth(); // already at the last level
+            if (taskTable.tier[activeTaskId] > tierBefore) MLFQ_STAT(++statistics->levels[activeLevel].demotions);
+            int nextSelected = levels.selectNextTask(activeLevel, activeTaskId);
+
+            if (nextSelected != activeTaskId){
+                // *** PREEMPTION (e.g., quantum expired in RR) ***
+                levels.handleTaskExit(activeLevel, activeTaskId);
+                MLFQ_TRACE(end(now + 1, TraceExit::SLICE_EXPIRED));
+
+                // *** Level movement if applicable ***
+                // RR already incremented the task's tier when quantum expired (capped at depth above).
+                levels.purgeTask(activeLevel, activeTaskId); // remove from current level
+                assignToLevel(activeTaskId);                    // re-queue globally according to 'tier'
+
+                activeTaskId = nextSelected;                      // might be -1 if no more here
+                if (activeTaskId != -1) aging.remove(activeTaskId);
+                if (activeTaskId != -1 && taskTable.startMoment[activeTaskId] < 0)
+                    taskTable.startMoment[activeTaskId] = now + 1;
+                if (activeTaskId != -1) MLFQ_STAT(++statistics->levels[activeLevel].dispatches);
+                if (activeTaskId != -1) MLFQ_TRACE(begin(activeTaskId, activeLevel, now + 1));
+            }
+        }
+        return 1;
+    }
+
+private:
+    TaskTable& taskTable;
+    Levels& levels;
+    const bool eventDriven, perTickWaiting;
+    SchedulerStatistics* statistics;
+    ExecutionTrace* trace;
+
+    const StarvationPolicy starvation;
+    int activeTaskId = -1, activeLevel = -1;
+    int completed = 0, justCompleted = -1;
+    long long executedUnits = 0;
+    int accountingClock = 0;
+    int nextBoost;  // time of the next global boost (NO_HORIZON: boosting off)
+    // (wake-up time, task) min-heap; equal times wake in identifier order, like arrivals
+    struct WakesLater {
+        const TaskTable* table;
+        bool operator()(const std::pair<int,int>& a, const std::pair<int,int>& b) const {
+            if (a.first != b.first) return a.first > b.first;
+            int rankA = table->identifierRank[a.second], rankB = table->identifierRank[b.second];
+            return rankA != rankB ? rankA > rankB : a.second > b.second;
+        }
+    };
+    EngineScratch ownScratch;                  // buffers when the caller keeps none
+    std::vector<std::pair<int,int>>& blocked;  // heap ordered by WakesLater
+    AgingList& aging;                          // waiting tasks below level 0 (agingThreshold > 0)
+    WakesLater wakesLater;
+
+    int levelOf(int taskId) const {
+        // Level indicated by task's current tier (1..depth)
+        return std::max(1, std::min(levels.depth(), taskTable.tier[taskId])) - 1;
+    }
+    void assignToLevel(int taskId) {
+        enqueue(levelOf(taskId), taskId);
+    }
+    // Every ready-queue entry goes through here, so aging knows when it started waiting
+    void enqueue(int level, int taskId) {
+        levels.addToQueue(level, taskId);
+        queuedBy(level, taskId);
+    }
+    void queuedBy(int level, int taskId) {
+        if (starvation.agingThreshold > 0 && level > 0) aging.pushBack(taskId, accountingClock, taskTable.size());
+    }
+
+    int nextAgingDeadline() const {
+        if (aging.front() == -1) return NO_HORIZON;
+        int entered = aging.enteredAt(aging.front());
+        return entered > NO_HORIZON - starvation.agingThreshold ? NO_HORIZON : entered + starvation.agingThreshold;
+    }
+
+    // Ready task moves from level 'from' up to level 'to', queued behind that level's tasks
+    void promote(int from, int to, int taskId) {
+        levels.purgeTask(from, taskId);
+        aging.remove(taskId);
+        taskTable.tier[taskId] = to + 1;
+        enqueue(to, taskId);
+        MLFQ_STAT(++statistics->levels[from].promotions);
+    }
+
+    // Tasks that have waited agingThreshold units in their queue move up one level
+    void promoteAged(int now) {
+        for (int taskId = aging.front(); taskId != -1 && aging.enteredAt(taskId) <= now - starvation.agingThreshold;
+             taskId = aging.front()){
+            int level = levelOf(taskId);
+            promote(level, level - 1, taskId);
+        }
+    }
+
+    // Every task back to the top level: the running one (unless already there) first,
+    // then each lower level's queue in its own order; blocked tasks wake up at tier 1
+    void boostAll(int now) {
+        const long long following = (static_cast<long long>(now) / starvation.boostInterval + 1) * starvation.boostInterval;
+        nextBoost = following >= NO_HORIZON ? NO_HORIZON : static_cast<int>(following);
+        if (activeTaskId != -1 && activeLevel > 0){
+            levels.handleTaskExit(activeLevel, activeTaskId);
+            MLFQ_TRACE(end(now, TraceExit::PREEMPTED));
+            promote(activeLevel, 0, activeTaskId);
+            activeTaskId = -1; activeLevel = -1;
+        }
+        for (int level = 1; level < levels.depth(); ++level){
+            while (levels.hasWork(level)){
+                int taskId = levels.peekNextTask(level);
+                if (taskId == -1) break; // the level cannot name its next task
+                promote(level, 0, taskId);
+            }
+        }
+        for (const auto& entry : blocked) taskTable.tier[entry.second] = 1;
+    }
+    void updateWaitingTasks(int runningTask) {
+        if (perTickWaiting) levels.updateWaitingTimes(runningTask);
+    }
+    void sampleQueueLengths(int units) {
+        for (int i = 0; i < levels.depth() && i < static_cast<int>(statistics->levels.size()); ++i)
+            statistics->levels[i].queueLengthHistogram[queueLengthBucket(levels.queueLength(i))] += units;
+    }
+};
+
+// Run the simulation to completion on a single CPU, updating taskTable in place.
+// 'arrivalSequence' is arrivalOrder(taskTable), computed once for a prepared workload
+template <class Levels>
+void simulateMLFQ(TaskTable& taskTable, Levels& levels, const SimulationOptions& options, EngineScratch& scratch,
+                  const std::vector<int>& arrivalSequence){
+    size_t nextArrivalIndex = 0;
+
+    MLFQCore<Levels> cpu(taskTable, levels, options, &scratch);
+    int currentTime = 0;
+    // Time keeps moving while tasks sit in I/O: advance() caps each step at the next wake-up
+    while (cpu.completedTasks() < taskTable.size()){
+        // Process arrivals at current time
+        while (nextArrivalIndex < arrivalSequence.size() && taskTable.arrivalMoment[arrivalSequence[nextArrivalIndex]] == currentTime){
+            cpu.admit(arrivalSequence[nextArrivalIndex], currentTime);
+            ++nextArrivalIndex;
+        }
+        int horizon = nextArrivalIndex < arrivalSequence.size()
+            ? taskTable.arrivalMoment[arrivalSequence[nextArrivalIndex]] : MLFQCore<Levels>::NO_HORIZON;
+        currentTime += cpu.advance(currentTime, horizon);
+    }
+}
+
+template <class Levels>
+void simulateMLFQ(TaskTable& taskTable, Levels& levels, const SimulationOptions& options, EngineScratch& scratch){
+    arrivalOrder(taskTable, scratch.arrivalSequence);
+    simulateMLFQ(taskTable, levels, options, scratch, scratch.arrivalSequence);
+}
+
+template <class Levels>
+void simulateMLFQ(TaskTable& taskTable, Levels& levels, const SimulationOptions& options){
+    EngineScratch scratch;
+    simulateMLFQ(taskTable, levels, options, scratch);
+}
@@ -0,0 +1,88 @@
+#pragma once
+#include "mlfq.h"
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// =============================================================
+// Runtime-configured MLFQ levels
+// =============================================================
+
+struct SchedulingLevel {
+    LevelConfiguration config;
+    std::unique_ptr<SchedulingStrategy> scheduler;
+
+    SchedulingLevel() = default;
+    explicit SchedulingLevel(const LevelConfiguration& c, TaskTable& tasks) : config(c) {
+        switch (config.strategy) {
+            case SchedulingMode::ROUND_ROBIN:   scheduler = createRoundRobinStrategy(tasks, config.timeSlice); break;
+            case SchedulingMode::SHORTEST_FIRST:  scheduler = createShortestJobStrategy(tasks); break;
+            case SchedulingMode::SHORTEST_REMAINING: scheduler = createPreemptiveShortestStrategy(tasks); break;
+        }
+    }
+    bool hasWork() const { return scheduler->hasWaitingTasks(); }
+};
+
+// Level setup of the fixed schemes A/B/C and registered ones (throws on an unknown scheme).
+// A registered scheme's levels change if its label is registered again.
+const LevelScheme& defineAlgorithmScheme(char algorithmType);
+
+// One strategy object per level behind virtual dispatch, any depth up to MAX_LEVELS.
+// Every call that can change a level's queue refreshes its bit in 'ready'.
+struct DynamicLevels {
+    std::vector<SchedulingLevel> schedulingLevels;
+    ReadyLevels ready;
+
+    DynamicLevels(const LevelScheme& algorithmConfig, TaskTable& taskTable) {
+        if (algorithmConfig.empty() || algorithmConfig.size() > static_cast<size_t>(MAX_LEVELS))
+            throw std::invalid_argument("❌ A scheme needs 1 to " + std::to_string(MAX_LEVELS) + " levels.");
+        schedulingLevels.reserve(algorithmConfig.size());
+        for (const auto& level : algorithmConfig) schedulingLevels.emplace_back(level, taskTable);
+    }
+
+    SchedulingStrategy& at(int level) const { return *schedulingLevels[level].scheduler; }
+
+    int  depth() const { return static_cast<int>(schedulingLevels.size()); }
+    int  firstReadyLevel() const { return ready.first(); }
+    bool hasWork(int level) const { return ready.has(level); }
+    int  queueLength(int level) const { return at(level).queueLength(); }
+    void addToQueue(int level, int taskId) { at(level).addToQueue(taskId); ready.update(level, true); }
+    int  selectNextTask(int level, int currentTaskId) {
+        int selected = at(level).selectNextTask(currentTaskId);
+        ready.update(level, at(level).hasWaitingTasks());
+        return selected;
+    }
+    int  peekNextTask(int level) const { return at(level).peekNextTask(); }
+    void processTimeUnit(int level, int taskId) { at(level).processTimeUnit(taskId); }
+    void processTimeUnits(int level, int taskId, int units) { at(level).processTimeUnits(taskId, units); }
+    int  runBudget(int level, int taskId) const { return at(level).runBudget(taskId); }
+    void handleTaskExit(int level, int taskId) { at(level).handleTaskExit(taskId); }
+    void purgeTask(int level, int taskId) { at(level).purgeTask(taskId); ready.update(level, at(level).hasWaitingTasks()); }
+
+    void updateWaitingTimes(int runningTaskId) {
+        for (auto& level : schedulingLevels) level.scheduler->updateWaitingTimes(runningTaskId);
+    }
+    void accumulateWaitingTimes(int runningTaskId, int units) {
+        for (auto& level : schedulingLevels) level.scheduler->accumulateWaitingTimes(runningTaskId, units);
+    }
+    void enableTimestampAccounting(const int* clock) {
+        for (auto& level : schedulingLevels) level.scheduler->enableTimestampAccounting(clock);
+    }
+    void reset() {
+        for (auto& level : schedulingLevels) level.scheduler->reset();
+        ready.clear();
+    }
+    void refreshRank(int taskId) {
+        for (auto& level : schedulingLevels) level.scheduler->refreshRank(taskId);
+    }
+    void saveState(SavedState& state) const {
+        for (const auto& level : schedulingLevels) level.scheduler->saveState(state);
+    }
+    void restoreState(StateReader& state) {
+        for (int level = 0; level < depth(); ++level) {
+            at(level).restoreState(state);
+            ready.update(level, at(level).hasWaitingTasks());
+        }
+    }
+};
@@ -1,8 +1,15 @@
 #include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <chrono>
 #include <string>
 #include <vector>
 #include <cstring>
+#include <filesystem>
+#include <stdexcept>
 #include "mlfq.h"
+#include "trace.h"
 
 // Main entry point: handles argument parsing, input loading,
 // algorithm execution, and consolidated report generation.
@@ -12,9 +19,21 @@ using namespace std;
 int main(int argc, char** argv) {
     ios::sync_with_stdio(false);
 
-    string inputFilePath, outputFilePath;
+    string inputFilePath, outputFilePath, batchSource, statisticsFilePath, traceFilePath;
+    unsigned workerThreads = 0; // 0: one per hardware thread
+    SimulationOptions simulationOptions;
+    ReportOptions reportOptions;
+    vector<char> schemes{'A', 'B', 'C'};
+    vector<string> schemeSpecs;
+    TuningOptions tuningOptions;
+    bool tuning = false;
+    bool streaming = false;
+    char streamScheme = 0; // 0: first selected scheme
+    MultiCpuOptions cpuOptions;
+    bool multiCpu = false;
+    bool starvationReport = false;
 
-    // Helper function to detect prefixes like --in= and --out=
+    // Helper function to detect prefixes like --in=, --out= and --engine=
     auto hasPrefix = [](const string& text, const char* prefix){
         size_t prefixLength = strlen(prefix);
         return text.size() >= prefixLength && text.compare(0, prefixLength, prefix) == 0;
@@ -27,26 +46,266 @@ int main(int argc, char** argv) {
             inputFilePath = argument.substr(5);
         } else if (hasPrefix(argument, "--out=")) {
             outputFilePath = argument.substr(6);
+        } else if (hasPrefix(argument, "--engine=")) {
+            string engineName = argument.substr(9);
+            if (engineName == "tick") simulationOptions.engine = EngineMode::TICK;
+            else if (engineName == "event") simulationOptions.engine = EngineMode::EVENT;
+            else return 1;
+        } else if (hasPrefix(argument, "--accounting=")) {
+            string accountingName = argument.substr(13);
+            if (accountingName == "tick") simulationOptions.waitAccounting = WaitAccounting::PER_TICK;
+            else if (accountingName == "timestamp") simulationOptions.waitAccounting = WaitAccounting::TIMESTAMP;
+            else return 1;
+        } else if (hasPrefix(argument, "--dispatch=")) {
+            string dispatchName = argument.substr(11);
+            if (dispatchName == "dynamic") simulationOptions.dispatch = DispatchMode::DYNAMIC;
+            else if (dispatchName == "static") simulationOptions.dispatch = DispatchMode::STATIC;
+            else return 1;
+        } else if (hasPrefix(argument, "--stats=")) {
+            statisticsFilePath = argument.substr(8);
+        } else if (hasPrefix(argument, "--trace=")) {
+            traceFilePath = argument.substr(8);
+            if (traceFilePath.empty()) return 1;
+        } else if (hasPrefix(argument, "--scheme=")) {
+            schemeSpecs.push_back(argument.substr(9));
+        } else if (argument == "--tune") {
+            tuning = true;
+        } else if (hasPrefix(argument, "--tune-quanta=")) {
+            tuningOptions.quanta.clear();
+            for (const char* cursor = argument.c_str() + 14; *cursor; ) {
+                char* stop = nullptr;
+                long quantum = strtol(cursor, &stop, 10);
+                if (stop == cursor || quantum <= 0) return 1;
+                tuningOptions.quanta.push_back(static_cast<int>(quantum));
+                cursor = (*stop == ',') ? stop + 1 : stop;
+                if (*stop && *stop != ',') return 1;
+            }
+            tuning = true;
+        } else if (argument == "--stream") {
+            streaming = true;
+        } else if (hasPrefix(argument, "--stream=")) {
+            if (argument.size() != 10) return 1;
+            streaming = true;
+            streamScheme = argument[9];
+        } else if (argument == "--percentiles") {
+            reportOptions.tailLatency = true;
+        } else if (argument == "--throughput") {
+            reportOptions.throughput = true;
+        } else if (hasPrefix(argument, "--batch=")) {
+            batchSource = argument.substr(8);
+        } else if (hasPrefix(argument, "--jobs=")) {
+            workerThreads = static_cast<unsigned>(strtoul(argument.c_str() + 7, nullptr, 10));
+        } else if (hasPrefix(argument, "--cpus=")) {
+            cpuOptions.cpuCount = atoi(argument.c_str() + 7);
+            if (cpuOptions.cpuCount < 1) return 1;
+            multiCpu = true;
+        } else if (hasPrefix(argument, "--migration-cost=")) {
+            cpuOptions.migrationCost = atoi(argument.c_str() + 17);
+            if (cpuOptions.migrationCost < 0) return 1;
+        } else if (hasPrefix(argument, "--balance=")) {
+            cpuOptions.balanceInterval = atoi(argument.c_str() + 10);
+            if (cpuOptions.balanceInterval < 1) return 1;
+        } else if (hasPrefix(argument, "--boost=")) {
+            simulationOptions.starvation.boostInterval = atoi(argument.c_str() + 8);
+            if (simulationOptions.starvation.boostInterval < 1) return 1;
+        } else if (hasPrefix(argument, "--aging=")) {
+            simulationOptions.starvation.agingThreshold = atoi(argument.c_str() + 8);
+            if (simulationOptions.starvation.agingThreshold < 1) return 1;
+        } else if (argument == "--starvation-report") {
+            starvationReport = true;
         }
     }
 
+    // --scheme=<spec> (repeatable) replaces A/B/C with the given schemes, labelled 1, 2, ...
+    if (schemeSpecs.size() > 9) return 1;
+    if (!schemeSpecs.empty()) {
+        schemes.clear();
+        try {
+            for (size_t index = 0; index < schemeSpecs.size(); ++index) {
+                char label = static_cast<char>('1' + index);
+                registerScheme(label, parseSchemeSpec(schemeSpecs[index]));
+                schemes.push_back(label);
+            }
+        } catch (const exception& error) {
+            cerr << error.what() << '\n';
+            return 1;
+        }
+    }
+
+    // Batch mode: --batch=<directory|list file> writes one report per input into --out=<directory>
+    if (!batchSource.empty()) {
+        if (outputFilePath.empty()) return 1;
+        try {
+            auto summary = runBatch(collectBatchInputs(batchSource), outputFilePath, schemes, simulationOptions, reportOptions, workerThreads);
+            double jobsPerSecond = summary.wallSeconds > 0 ? summary.jobs / summary.wallSeconds : 0.0;
+            cerr << "⏱️ batch: " << summary.inputs << " files, " << summary.jobs << " jobs in "
+                 << fixed << setprecision(3) << summary.wallSeconds << " s ("
+                 << setprecision(1) << jobsPerSecond << " jobs/s)\n";
+            return summary.failures == 0 ? 0 : 3;
+        } catch (const exception&) {
+            return 3;
+        }
+    }
+
+    // Streaming mode: --stream[=<scheme>] reads --in (or stdin) in arrival order and writes
+    // each task's row to --out (or stdout) as soon as it completes
+    if (streaming) {
+        ifstream inputFile;
+        ofstream outputFile;
+        istream* input = &cin;
+        ostream* output = &cout;
+        if (!inputFilePath.empty() && inputFilePath != "-") {
+            inputFile.open(inputFilePath, ios::binary);
+            if (!inputFile) return 3;
+            input = &inputFile;
+        }
+        if (!outputFilePath.empty() && outputFilePath != "-") {
+            outputFile.open(outputFilePath, ios::binary);
+            if (!outputFile) return 2;
+            output = &outputFile;
+        }
+        try {
+            char scheme = streamScheme ? streamScheme : schemes.front();
+            MetricsAccumulator metrics;
+            OnlineScheduler scheduler(scheme, simulationOptions, [&](const Task& task){
+                writeTaskLine(*output, task);
+                metrics.add(task);
+            });
+            *output << "📈 Algorithm " << algorithmDescription(scheme) << '\n';
+            *output << "identifier; BT; AT; Q; Pr; WT; CT; RT; TAT\n";
+
+            TaskReader reader(*input);
+            Task task;
+            while (reader.next(task)) {
+                if (task.arrivalMoment < scheduler.now())
+                    throw runtime_error("❌ Line " + to_string(reader.lineNumber()) + ": arrival time " + to_string(task.arrivalMoment)
+                                        + " is earlier than a previous task (stream mode needs arrival order)");
+                scheduler.admit(task);
+            }
+            scheduler.finish();
+            writeMeansLine(*output, metrics);
+            if (reportOptions.tailLatency) writeTailLatencyReport(*output, {{scheme, &metrics}});
+            if (reportOptions.throughput || metrics.ioTasks > 0) writeThroughputReport(*output, {{scheme, &metrics}});
+            output->flush();
+            if (!*output) return 2;
+        } catch (const exception& error) {
+            cerr << error.what() << '\n';
+            return 3;
+        }
+        return 0;
+    }
+
     // Exit with error code if required paths are missing
     if (inputFilePath.empty() || outputFilePath.empty()) return 1;
 
+    // Tuner: --tune[-quanta=...] writes the Pareto front of schemes for the input workload
+    if (tuning) {
+        try {
+            tuningOptions.simulation = simulationOptions;
+            tuningOptions.threadCount = workerThreads;
+            auto result = tuneSchemes(PreparedWorkload(parseInputFile(inputFilePath)), tuningOptions);
+            ofstream outputStream(outputFilePath, ios::binary);
+            if (!outputStream) return 2;
+            writeTuningReport(outputStream, result);
+            cerr << "⏱️ tune: " << result.candidates << " candidates, " << result.pruned << " pruned, "
+                 << result.front.size() << " on the front in " << fixed << setprecision(3) << result.wallSeconds << " s\n";
+        } catch (const exception&) {
+            return 3;
+        }
+        return 0;
+    }
+
     try {
-        // Load task list from input file
-        auto taskCollection = parseInputFile(inputFilePath);
+        using Clock = chrono::steady_clock;
+        auto secondsSince = [](Clock::time_point start){ return chrono::duration<double>(Clock::now() - start).count(); };
+        const bool collectStatistics = !statisticsFilePath.empty();
+
+        // Load task list from input file, interned and ordered once for every scheme
+        auto phaseStart = Clock::now();
+        const PreparedWorkload workload(parseInputFile(inputFilePath));
+        const auto& taskCollection = workload.tasks();
+        double parseSeconds = secondsSince(phaseStart);
 
         // Execute different algorithm schemes and collect results
         vector<pair<char, vector<Task>>> algorithmResults;
-        algorithmResults.emplace_back('A', executeMLFQ(taskCollection, 'A'));
-        algorithmResults.emplace_back('B', executeMLFQ(taskCollection, 'B'));
-        algorithmResults.emplace_back('C', executeMLFQ(taskCollection, 'C'));
+        vector<pair<char, SchedulerStatistics>> schemeStatistics;
+        vector<pair<char, MultiCpuResult>> cpuResults;
+        cpuOptions.threadCount = workerThreads;
+        SimulationContext context; // table and levels reused from scheme to scheme
+        vector<ExecutionTrace> traces(traceFilePath.empty() ? 0 : schemes.size());
+        phaseStart = Clock::now();
+        for (size_t index = 0; index < schemes.size(); ++index) {
+            char scheme = schemes[index];
+            SimulationOptions schemeOptions = simulationOptions;
+            if (collectStatistics) {
+                schemeStatistics.emplace_back(scheme, SchedulerStatistics{});
+                schemeOptions.statistics = &schemeStatistics.back().second;
+            }
+            if (!traceFilePath.empty()) schemeOptions.trace = &traces[index];
+            if (multiCpu) {
+                // --cpus=N: per-CPU queues with work stealing
+                cpuResults.emplace_back(scheme, executeMultiCpuMLFQ(taskCollection, scheme, cpuOptions, schemeOptions));
+                algorithmResults.emplace_back(scheme, move(cpuResults.back().second.tasks));
+            } else {
+                algorithmResults.emplace_back(scheme, context.run(workload, scheme, schemeOptions));
+            }
+        }
+
+        vector<PolicyOutcome> outcomes;
+        // --starvation-report: every scheme again (one CPU) without a policy, with a periodic
+        // boost, with aging and with both; --boost/--aging give the values, else DEFAULT_STARVATION_POLICY.
+        // Simulation work, so timed with the schemes rather than with the report
+        if (starvationReport) {
+            StarvationPolicy configured = simulationOptions.starvation;
+            if (configured.boostInterval <= 0) configured.boostInterval = DEFAULT_STARVATION_POLICY.boostInterval;
+            if (configured.agingThreshold <= 0) configured.agingThreshold = DEFAULT_STARVATION_POLICY.agingThreshold;
+            const StarvationPolicy policies[] = {
+                {}, {configured.boostInterval, 0}, {0, configured.agingThreshold}, configured};
+            for (char scheme : schemes) {
+                for (const auto& policy : policies) {
+                    SimulationOptions policyOptions = simulationOptions;
+                    policyOptions.starvation = policy;
+                    outcomes.push_back(PolicyOutcome{scheme, policy, MetricsAccumulator{}});
+                    for (const auto& task : context.run(workload, scheme, policyOptions)) outcomes.back().metrics.add(task);
+                }
+            }
+        }
+        double simulateSeconds = secondsSince(phaseStart);
+
+        // Optional execution trace (--trace=<file>): one file per scheme, "run.trace" -> "run.A.trace".
+        // Written once the simulation is timed, so file I/O stays out of simulate_ms
+        if (!traceFilePath.empty()) {
+            vector<string> identifiers;
+            identifiers.reserve(taskCollection.size());
+            for (const auto& task : taskCollection) identifiers.push_back(task.identifier);
+            for (size_t index = 0; index < schemes.size(); ++index) {
+                filesystem::path schemeTrace(traceFilePath);
+                schemeTrace.replace_filename(schemeTrace.stem().string() + '.' + schemes[index] + schemeTrace.extension().string());
+                writeTraceFile(schemeTrace.string(), traces[index], identifiers);
+            }
+        }
 
         // Write consolidated report
+        phaseStart = Clock::now();
         ofstream outputStream(outputFilePath, ios::binary);
         if (!outputStream) return 2;
-        writeConsolidatedReport(outputStream, algorithmResults);
+        writeConsolidatedReport(outputStream, algorithmResults, reportOptions);
+        if (multiCpu) writeUtilizationReport(outputStream, cpuResults);
+        if (starvationReport) writeStarvationReport(outputStream, outcomes);
+        outputStream.close();
+        double reportSeconds = secondsSince(phaseStart);
+
+        // Optional statistics report (--stats=<file>)
+        if (collectStatistics) {
+            for (auto& entry : schemeStatistics) {
+                entry.second.parseSeconds = parseSeconds;
+                entry.second.simulateSeconds = simulateSeconds;
+                entry.second.reportSeconds = reportSeconds;
+            }
+            ofstream statisticsStream(statisticsFilePath, ios::binary);
+            if (!statisticsStream) return 2;
+            writeStatisticsReport(statisticsStream, schemeStatistics);
+        }
     } catch (const exception&) {
         return 3;
     } catch (...) {
@@ -0,0 +1,69 @@
+#include "mappedfile.h"
+#include <stdexcept>
+
+#if defined(_WIN32)
+#  define WIN32_LEAN_AND_MEAN
+#  include <windows.h>
+#else
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+using namespace std;
+
+#if defined(_WIN32)
+
+MappedFile::MappedFile(const string& filepath){
+    HANDLE file = CreateFileA(filepath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) throw runtime_error("❌ Unable to open file: " + filepath);
+    LARGE_INTEGER fileSize{};
+    GetFileSizeEx(file, &fileSize);
+    fileHandle = file;
+    length = static_cast<size_t>(fileSize.QuadPart);
+    if (length == 0) return; // empty files cannot be mapped
+    mappingHandle = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mappingHandle) bytes = static_cast<const char*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+    if (!bytes){
+        if (mappingHandle) CloseHandle(mappingHandle);
+        CloseHandle(file);
+        throw runtime_error("❌ Unable to map file: " + filepath);
+    }
+}
+
+MappedFile::~MappedFile(){
+    if (bytes) UnmapViewOfFile(bytes);
+    if (mappingHandle) CloseHandle(mappingHandle);
+    if (fileHandle) CloseHandle(fileHandle);
+}
+
+#else
+
+MappedFile::MappedFile(const string& filepath){
+    int descriptor = open(filepath.c_str(), O_RDONLY);
+    if (descriptor < 0) throw runtime_error("❌ Unable to open file: " + filepath);
+    struct stat status{};
+    if (fstat(descriptor, &status) != 0){
+        close(descriptor);
+        throw runtime_error("❌ Unable to stat file: " + filepath);
+    }
+    length = static_cast<size_t>(status.st_size);
+    if (length > 0){
+        void* mapping = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, descriptor, 0);
+        if (mapping == MAP_FAILED){
+            close(descriptor);
+            throw runtime_error("❌ Unable to map file: " + filepath);
+        }
+        madvise(mapping, length, MADV_SEQUENTIAL);
+        bytes = static_cast<const char*>(mapping);
+    }
+    close(descriptor); // the mapping stays valid after closing
+}
+
+MappedFile::~MappedFile(){
+    if (bytes) munmap(const_cast<char*>(bytes), length);
+}
+
+#endif
@@ -0,0 +1,83 @@
+#include "mlfq.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+
+// Streaming metrics: one pass per scheme, memory independent of the task count
+
+namespace {
+    constexpr int subBuckets = 1 << LatencyHistogram::SUB_BUCKET_BITS;
+
+    int highestBit(unsigned long long value){
+        int bit = 0;
+        while (value >>= 1) ++bit;
+        return bit;
+    }
+
+    int bucketOf(long long value){
+        if (value < subBuckets) return static_cast<int>(max(0LL, value));
+        int exponent = highestBit(static_cast<unsigned long long>(value));
+        int shift = exponent - LatencyHistogram::SUB_BUCKET_BITS;
+        int subBucket = static_cast<int>(value >> shift) - subBuckets;
+        return ((shift + 1) << LatencyHistogram::SUB_BUCKET_BITS) + subBucket;
+    }
+
+    // Largest value that falls into 'bucket'
+    long long bucketUpperEdge(int bucket){
+        if (bucket < subBuckets) return bucket;
+        int shift = (bucket >> LatencyHistogram::SUB_BUCKET_BITS) - 1;
+        long long lower = static_cast<long long>(subBuckets + (bucket & (subBuckets - 1))) << shift;
+        return lower + ((1LL << shift) - 1);
+    }
+}
+
+void LatencyHistogram::add(long long value){
+    ++buckets[bucketOf(value)];
+    ++samples;
+    largest = max(largest, value);
+}
+
+long long LatencyHistogram::quantile(double fraction) const {
+    if (samples == 0) return 0;
+    long long rank = static_cast<long long>(ceil(fraction * static_cast<double>(samples)));
+    rank = min(samples, max(1LL, rank));
+    long long seen = 0;
+    for (int bucket = 0; bucket < BUCKET_COUNT; ++bucket){
+        seen += buckets[bucket];
+        if (seen >= rank) return min(largest, bucketUpperEdge(bucket));
+    }
+    return largest;
+}
+
+void MetricsAccumulator::add(const Task& task){
+    long long started = task.startMoment < 0 ? 0 : task.startMoment;
+    long long responseTime = task.startMoment < 0 ? 0 : task.startMoment - task.arrivalMoment;
+    long long turnaroundTime = task.finishMoment < 0 ? 0 : task.finishMoment - task.arrivalMoment;
+
+    ++tasks;
+    waitingTotal += task.delayAccumulated;
+    completionTotal += task.finishMoment;
+    responseTotal += responseTime;
+    turnaroundTotal += turnaroundTime;
+    startTotal += started;
+    busyTotal += task.serviceDuration;
+    makespan = max<long long>(makespan, task.finishMoment);
+    if (!task.bursts.empty()) ++ioTasks;
+
+    waiting.add(task.delayAccumulated);
+    response.add(responseTime);
+    turnaround.add(turnaroundTime);
+}
+
+PerformanceMetrics MetricsAccumulator::means() const {
+    PerformanceMetrics metrics{};
+    if (tasks > 0){
+        double taskCount = static_cast<double>(tasks);
+        metrics.WT  = waitingTotal / taskCount;
+        metrics.CT  = completionTotal / taskCount;
+        metrics.RT  = responseTotal / taskCount;
+        metrics.TAT = turnaroundTotal / taskCount;
+    }
+    return metrics;
+}
@@ -1,8 +1,15 @@
 #pragma once
+#include <array>
+#include <climits>
+#include <cstdint>
+#include <functional>
 #include <string>
 #include <vector>
 #include <memory>
 #include <iosfwd>
+#if defined(_MSC_VER)
+#  include <intrin.h>
+#endif
 
 // =============================================================
 // Task models and scheduler interface definitions
@@ -16,8 +23,9 @@ public:
     int arrivalMoment = 0;    // when task enters system
 
     // Scheduling metadata
-    int tier  = 1;           // queue level 1..4
+    int tier  = 1;           // queue level 1..depth of the scheme
     int priority = 1;        // priority value (5 > 1)
+    std::vector<int> bursts; // alternating CPU, I/O, ..., CPU units (CPU sum == serviceDuration); empty: pure CPU
 
     // Execution state and metrics
     int timeLeft = 0;        // remaining execution time
@@ -28,46 +36,553 @@ public:
     Task() = default;
 };
 
+// Flat simulation state for checkpoints: each component appends its words with
+// saveState() and reads them back, in the same order, with restoreState()
+struct SavedState {
+    std::vector<int> words;
+
+    void put(int value) { words.push_back(value); }
+    void putWide(long long value) {
+        put(static_cast<int>(value >> 32));
+        put(static_cast<int>(static_cast<unsigned long long>(value) & 0xFFFFFFFFu));
+    }
+};
+
+class StateReader {
+public:
+    explicit StateReader(const SavedState& state) : words(state.words) {}
+    int  next();                            // throws runtime_error past the end
+    long long nextWide();
+    bool exhausted() const { return position == words.size(); }
+private:
+    const std::vector<int>& words;
+    size_t position = 0;
+};
+
+class PreparedWorkload;
+
+// Struct-of-arrays task table used by the engine and the strategies.
+// Hot scheduling fields live in separate contiguous arrays indexed by task ID;
+// identifiers are interned once into dense ranks that keep their
+// lexicographic order, so tie-breaks compare integers instead of strings.
+// The original Task records stay reachable for reporting through task()/toTasks().
+class TaskTable {
+public:
+    // Hot scheduling state
+    std::vector<int> timeLeft;
+    std::vector<int> arrivalMoment;
+    std::vector<int> tier;
+    std::vector<int> delayAccumulated;
+    std::vector<int> readySince;      // entry time into current ready queue (timestamp accounting)
+    std::vector<int> identifierRank;  // interned identifier, lexicographic order
+    std::vector<int> burstLeft;       // CPU units before the task blocks for I/O (timeLeft when it never does)
+
+    // Cold state, only touched on dispatch and completion
+    std::vector<int> startMoment;
+    std::vector<int> finishMoment;
+    std::vector<int> burstIndex;      // current CPU burst in the source record's 'bursts'
+
+    TaskTable() = default;
+    explicit TaskTable(const std::vector<Task>& tasks) { load(tasks); }
+
+    void load(const std::vector<Task>& tasks);  // intern identifiers and reset run state (reuses storage)
+    void load(const std::vector<Task>& tasks, const std::vector<int>& ranks); // ranks already interned
+    void load(const PreparedWorkload& workload); // copy of its initial table, column by column
+
+    // Streaming use: report records live in 'tasks', slots are (re)initialised one at a time;
+    // assigning slot size() appends one
+    void bind(const std::vector<Task>& tasks) { source = &tasks; }
+    void assign(int taskId, const Task& task, int rank);
+    int  size() const { return static_cast<int>(timeLeft.size()); }
+
+    // CPU burst just finished: returns the I/O time that follows and loads the next CPU burst
+    int beginIo(int taskId);
+
+    // Checkpoints: run state of the tasks that arrived before 'time'; the others keep
+    // the initial state load() gave them (so their input may differ on restore)
+    void saveRunState(SavedState& state, int time) const;
+    void restoreRunState(StateReader& state);
+
+    // Strict (burstLeft, arrivalMoment, identifier) order used by the shortest-first levels:
+    // shortest next CPU burst, which is the whole remaining time for tasks without I/O
+    bool precedes(int a, int b) const {
+        if (burstLeft[a] != burstLeft[b]) return burstLeft[a] < burstLeft[b];
+        if (arrivalMoment[a] != arrivalMoment[b]) return arrivalMoment[a] < arrivalMoment[b];
+        return identifierRank[a] < identifierRank[b];
+    }
+
+    // Reporting view: the source record with this table's run state applied
+    Task task(int taskId) const;
+    std::vector<Task> toTasks() const;
+    void toTasks(std::vector<Task>& records) const;  // into existing records, reusing their storage
+
+private:
+    const std::vector<Task>* source = nullptr;
+    std::vector<int> internOrder;  // load() scratch
+
+    void initialise(const std::vector<Task>& tasks);
+};
+
+// Dense ranks preserving lexicographic identifier order (equal names share a rank)
+std::vector<int> internIdentifiers(const std::vector<Task>& tasks);
+void internIdentifiers(const std::vector<Task>& tasks, std::vector<int>& ranks, std::vector<int>& order); // 'order': scratch
+
 // ========= Scheduling strategy types and queue setup =========
 enum class SchedulingMode { ROUND_ROBIN, SHORTEST_FIRST, SHORTEST_REMAINING };
 
+// Simulation engine: TICK advances one time unit per iteration, EVENT jumps
+// straight to the next arrival, quantum expiry, completion or preemption.
+enum class EngineMode { TICK, EVENT };
+
+// Waiting-time accounting: PER_TICK walks every ready queue each unit,
+// TIMESTAMP derives waiting time from ready-queue entry/exit times.
+enum class WaitAccounting { PER_TICK, TIMESTAMP };
+
+// Level dispatch: DYNAMIC builds the levels at runtime behind virtual calls,
+// STATIC runs a compile-time pipeline (pipeline.h) when one exists for the scheme.
+enum class DispatchMode { DYNAMIC, STATIC };
+
+// Optional scheduler statistics (engine counters compile out with -DMLFQ_NO_STATS)
+struct LevelStatistics {
+    long long dispatches = 0;   // context switches onto a task of this level
+    long long demotions = 0;    // quantum expiries that bumped the task's tier
+    long long preemptions = 0;  // running task displaced by a higher level
+    long long promotions = 0;   // tasks lifted out of this level by aging or a boost
+    // Time units spent with the ready queue length in bucket k: 0, 1, 2-3, 4-7, ...
+    std::array<long long, 33> queueLengthHistogram{};
+};
+
+struct SchedulerStatistics {
+    std::vector<LevelStatistics> levels;  // one per level, sized by the engine
+    double parseSeconds = 0.0, simulateSeconds = 0.0, reportSeconds = 0.0; // wall clock
+};
+
+class ExecutionTrace;
+
+// Starvation prevention, off by default (tasks then only ever move down). Both rules
+// are evaluated at the start of a time unit; a task promoted to the top level no longer ages.
+struct StarvationPolicy {
+    int boostInterval = 0;   // every N units every task goes back to the top level (0: off)
+    int agingThreshold = 0;  // a ready task waiting N units in one queue moves up a level (0: off)
+
+    bool enabled() const { return boostInterval > 0 || agingThreshold > 0; }
+};
+std::string describePolicy(const StarvationPolicy& policy); // "none", "boost=50", "aging=20", "boost=50+aging=20"
+// Values --starvation-report and the bench "policy" rows use when none are given, so their numbers compare
+constexpr StarvationPolicy DEFAULT_STARVATION_POLICY{50, 20};
+
+struct SimulationOptions {
+    EngineMode engine = EngineMode::TICK;
+    WaitAccounting waitAccounting = WaitAccounting::PER_TICK;
+    DispatchMode dispatch = DispatchMode::DYNAMIC;
+    SchedulerStatistics* statistics = nullptr; // collect per-level counters when set
+    ExecutionTrace* trace = nullptr;           // record run segments when set (trace.h)
+    StarvationPolicy starvation;
+};
+
 struct LevelConfiguration {
     SchedulingMode strategy = SchedulingMode::ROUND_ROBIN;
     int timeSlice = 1;
 };
 
+// Levels of a scheme, highest priority first. A/B/C have four; any depth from 1 to
+// MAX_LEVELS works (tasks demote one level per expired RR quantum, down to the last).
+using LevelScheme = std::vector<LevelConfiguration>;
+constexpr int MAX_LEVELS = 64;
+
+// Levels with ready tasks as bits (bit i: level i), kept up to date by the level
+// containers on every queue change; the highest-priority ready level is then a
+// count-trailing-zeros, whatever the depth
+class ReadyLevels {
+public:
+    void update(int level, bool ready) {
+        const std::uint64_t bit = std::uint64_t{1} << level;
+        bits = ready ? (bits | bit) : (bits & ~bit);
+    }
+    bool has(int level) const { return (bits >> level) & 1u; }
+    void clear() { bits = 0; }
+
+    int first() const {  // -1: every level is empty
+        if (!bits) return -1;
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward64(&index, bits);
+        return static_cast<int>(index);
+#else
+        return __builtin_ctzll(bits);
+#endif
+    }
+
+private:
+    std::uint64_t bits = 0;
+};
+
+// Schemes given as text: 1 to MAX_LEVELS comma-separated levels, each RR:<quantum>, SJF or STCF
+// (e.g. "RR:2,RR:3,RR:4,STCF"). Registered schemes run under their label next
+// to the built-in A/B/C; register before any simulation starts.
+LevelScheme parseSchemeSpec(const std::string& spec);      // throws on malformed specs
+std::string formatSchemeSpec(const LevelScheme& levels);   // inverse of parseSchemeSpec
+std::string describeScheme(const LevelScheme& levels);     // "RR(2), RR(3), RR(4), STCF"
+void registerScheme(char label, const LevelScheme& levels);
+const LevelScheme* findRegisteredScheme(char label);       // nullptr when unknown
+
 // Abstract base for scheduling strategies
 class SchedulingStrategy {
 protected:
-    std::vector<Task>& taskList; // shared reference to all tasks
+    TaskTable& taskTable; // shared reference to all tasks
+    const int* readyClock = nullptr; // engine clock when timestamp accounting is enabled
+
+    // Ready-queue entry/exit bookkeeping (no-ops under per-tick accounting)
+    void markReady(int taskId) {
+        if (readyClock) taskTable.readySince[taskId] = *readyClock;
+    }
+    void markDispatched(int taskId) {
+        if (!readyClock || taskTable.readySince[taskId] < 0) return;
+        taskTable.delayAccumulated[taskId] += *readyClock - taskTable.readySince[taskId];
+        taskTable.readySince[taskId] = -1;
+    }
 
 public:
-    explicit SchedulingStrategy(std::vector<Task>& t) : taskList(t) {}
+    explicit SchedulingStrategy(TaskTable& t) : taskTable(t) {}
     virtual ~SchedulingStrategy() = default;
 
+    // Switch to timestamp accounting; 'clock' must outlive the strategy
+    void enableTimestampAccounting(const int* clock) { readyClock = clock; }
+
+    // Forget every task for a new run over the (reloaded) table, keeping storage
+    virtual void reset() { readyClock = nullptr; }
+    // A task's identifier rank was renumbered, order unchanged (streaming relabel): drop cached copies
+    virtual void refreshRank(int /*taskId*/) {}
+    // Checkpoints: queue contents and per-task bookkeeping of this level. restoreState
+    // follows a reset() and a reload of the table, and must not touch ready timestamps
+    virtual void saveState(SavedState& state) const = 0;
+    virtual void restoreState(StateReader& state) = 0;
+
     // Core scheduling lifecycle events
     virtual void addToQueue(int taskId) = 0;                 // task arrives at this level
     virtual bool hasWaitingTasks() const = 0;                // any ready tasks at this level?
+    virtual int  queueLength() const { return hasWaitingTasks() ? 1 : 0; } // ready tasks (statistics)
     virtual int  selectNextTask(int currentTaskId) = 0;      // choose next task ID (or keep current)
+    virtual int  peekNextTask() const { return -1; }         // task selectNextTask(-1) would pick (-1: unknown)
     virtual void processTimeUnit(int taskId) = 0;            // execute one time unit for task
     virtual void handleTaskExit(int taskId) = 0;             // task finished or preempted
     virtual void purgeTask(int taskId) = 0;                  // remove from internal structures
-    virtual void updateWaitingTimes(int runningTaskId) = 0;  // increment wait time for others
+    virtual void updateWaitingTimes(int runningTaskId) { (void)runningTaskId; } // per-tick accounting only
+
+    // Event-driven engine support (defaults keep per-tick behaviour for any strategy)
+    virtual int  runBudget(int taskId) const { (void)taskId; return 1; }   // units before this level may switch away
+    virtual void processTimeUnits(int taskId, int units) {                   // execute several quiet time units
+        while (units-- > 0) processTimeUnit(taskId);
+    }
+    virtual void accumulateWaitingTimes(int runningTaskId, int units) {      // add 'units' of wait time to others
+        while (units-- > 0) updateWaitingTimes(runningTaskId);
+    }
 };
 
-// Factory functions for scheduling strategies (maintain public signatures)
-std::unique_ptr<SchedulingStrategy> createRoundRobinStrategy(std::vector<Task>& tasks, int timeQuantum);
-std::unique_ptr<SchedulingStrategy> createShortestJobStrategy(std::vector<Task>& tasks);
-std::unique_ptr<SchedulingStrategy> createPreemptiveShortestStrategy(std::vector<Task>& tasks);
+// Factory functions for scheduling strategies
+std::unique_ptr<SchedulingStrategy> createRoundRobinStrategy(TaskTable& tasks, int timeQuantum);
+std::unique_ptr<SchedulingStrategy> createShortestJobStrategy(TaskTable& tasks);
+std::unique_ptr<SchedulingStrategy> createPreemptiveShortestStrategy(TaskTable& tasks);
 
 // Input/Output and reporting utilities
 std::vector<Task> parseInputFile(const std::string& filepath);
 std::vector<Task> parseInputStream(std::istream& input);
+class ReportWriter;       // reportwriter.h
+struct MetricsAccumulator;
 void generateReport(std::ostream& stream, const std::vector<Task>& items);
+void generateReport(std::ostream& stream, const std::vector<Task>& items, MetricsAccumulator& metrics); // aggregates filled while writing
+void writeTaskLine(std::ostream& stream, const Task& task);  // one "identifier; BT; AT; Q; Pr; WT; CT; RT; TAT" row
+void writeTaskLine(ReportWriter& output, const Task& task);
+
+// Incremental reader for the input format: one record at a time, same rules as parseInputStream
+class TaskReader {
+public:
+    explicit TaskReader(std::istream& source) : input(source) {}
+    bool next(Task& task);                           // false at end of input; throws on malformed lines
+    size_t lineNumber() const { return lineCount; }  // line of the last record returned
+private:
+    std::istream& input;
+    std::string line;
+    size_t lineCount = 0;
+};
 std::vector<Task> executeMLFQ(const std::vector<Task>& input, char algorithm);
+std::vector<Task> executeMLFQ(const std::vector<Task>& input, char algorithm, const SimulationOptions& options);
+bool hasStaticPipeline(char algorithm);
+std::vector<Task> executeStaticMLFQ(const std::vector<Task>& input, char algorithm, const SimulationOptions& options);
+
+// An input preprocessed once for any number of runs (every scheme of the report, sweeps,
+// batch jobs): the task records, a task table in its initial state with the identifiers
+// interned, and the arrival order. A run copies the table instead of interning and sorting
+// again. Immutable once built, so threads can share one.
+class PreparedWorkload {
+public:
+    explicit PreparedWorkload(std::vector<Task> tasks);
+    PreparedWorkload(const PreparedWorkload&) = delete;  // the table points at 'records'
+    PreparedWorkload& operator=(const PreparedWorkload&) = delete;
+
+    const std::vector<Task>& tasks() const { return records; }
+    const TaskTable& initialTable() const { return table; }                // every task at level 1, nothing run
+    const std::vector<int>& arrivalSequence() const { return arrivals; }  // by (arrival, identifier, input order)
+    int size() const { return table.size(); }
+
+private:
+    std::vector<Task> records;
+    TaskTable table;
+    std::vector<int> arrivals;
+};
+
+// Reusable storage for repeated runs (batch jobs, sweeps, benchmarks): the task table,
+// the levels of each scheme seen so far and the engine buffers are reset in place
+// between runs, so runs on inputs no larger than earlier ones allocate nothing.
+// Results match executeMLFQ. Not thread-safe: keep one per thread.
+class SimulationContext {
+public:
+    SimulationContext();
+    ~SimulationContext();
+    SimulationContext(const SimulationContext&) = delete;
+    SimulationContext& operator=(const SimulationContext&) = delete;
+
+    // Valid until the next run; 'input' must stay alive while the result is used
+    const std::vector<Task>& run(const std::vector<Task>& input, char algorithm, const SimulationOptions& options);
+    const std::vector<Task>& run(const std::vector<Task>& input, char algorithm) { return run(input, algorithm, SimulationOptions{}); }
+    // Same results without interning or sorting: the run starts from a copy of the prepared table
+    const std::vector<Task>& run(const PreparedWorkload& workload, char algorithm, const SimulationOptions& options);
+
+private:
+    struct State;
+    std::unique_ptr<State> state;
+};
+
+// Checkpointed simulation for what-if studies and very long runs. A baseline run
+// snapshots the whole simulation state (task table, every level's queues, the
+// running and blocked tasks) every 'interval' time units; whatIf() restores the
+// last snapshot before the first time the modified input can make a difference
+// and re-simulates only the suffix. Snapshots can be written out and read back
+// to resume a run later. Results match executeMLFQ; statistics and traces only
+// cover the part actually simulated.
+class CheckpointedSimulation {
+public:
+    static constexpr int NO_LIMIT = INT_MAX;
+
+    // 'interval' 0: about 32 snapshots over the estimated makespan
+    explicit CheckpointedSimulation(char algorithm, const SimulationOptions& options = SimulationOptions{}, int interval = 0);
+    ~CheckpointedSimulation();
+    CheckpointedSimulation(const CheckpointedSimulation&) = delete;
+    CheckpointedSimulation& operator=(const CheckpointedSimulation&) = delete;
+
+    // Baseline from time 0, stopping at the first step boundary at or after 'until' (snapshotted there)
+    const std::vector<Task>& run(const std::vector<Task>& input, int until = NO_LIMIT);
+    // Carry the baseline on from its latest snapshot
+    const std::vector<Task>& resume(int until = NO_LIMIT);
+    // The baseline tasks with arrivals, bursts or identifiers changed (same task count,
+    // throws invalid_argument otherwise). The baseline and its snapshots are kept.
+    const std::vector<Task>& whatIf(const std::vector<Task>& modified);
+
+    bool   finished() const;     // every task completed in the last simulation
+    int    now() const;          // time the last simulation stopped at
+    int    resumedFrom() const;  // snapshot time the last simulation started from (0: from scratch)
+    size_t checkpoints() const;
+
+    // Binary snapshot file; load() throws runtime_error when it belongs to another input or scheme
+    void save(std::ostream& output) const;
+    void load(const std::vector<Task>& input, std::istream& source);
+
+private:
+    struct State;
+    std::unique_ptr<State> state;
+};
 
 // Performance metrics
 struct PerformanceMetrics { double WT = 0.0, CT = 0.0, RT = 0.0, TAT = 0.0; };
+
+// Fixed-size log-linear histogram of non-negative values: exact below 64,
+// then 32 sub-buckets per power of two (quantiles within ~3%), ~15 KB whatever the count
+class LatencyHistogram {
+public:
+    static constexpr int SUB_BUCKET_BITS = 5;
+    static constexpr int BUCKET_COUNT = (64 - SUB_BUCKET_BITS) << SUB_BUCKET_BITS;
+
+    void add(long long value);
+    long long count() const { return samples; }
+    long long maximum() const { return largest; }
+    long long quantile(double fraction) const; // nearest rank; bucket upper edge capped at maximum()
+
+private:
+    std::array<long long, BUCKET_COUNT> buckets{};
+    long long samples = 0, largest = 0;
+};
+
+// Single pass over a scheme's tasks: sums for the means plus WT/RT/TAT tails.
+// RT here is first run minus arrival (the comparison table's definition);
+// startTotal keeps the raw first-run times shown in the per-task RT column.
+struct MetricsAccumulator {
+    long long tasks = 0;
+    long long waitingTotal = 0, completionTotal = 0, responseTotal = 0, turnaroundTotal = 0, startTotal = 0;
+    long long busyTotal = 0, makespan = 0, ioTasks = 0; // CPU units served, last completion, tasks doing I/O
+    LatencyHistogram waiting, response, turnaround;
+
+    void add(const Task& task);
+    PerformanceMetrics means() const;
+};
+
+struct ReportOptions {
+    bool tailLatency = false; // append p50/p90/p99/p99.9/max of WT, RT and TAT per scheme
+    bool throughput = false;  // append CPU utilization and throughput per scheme (always when tasks do I/O)
+};
+
+void writeMeansLine(std::ostream& os, const MetricsAccumulator& metrics);  // "WT=..; CT=..; RT=..; TAT=..;"
+void writeMeansLine(ReportWriter& output, const MetricsAccumulator& metrics);
+void writeTailLatencyReport(std::ostream& os, const std::vector<std::pair<char, const MetricsAccumulator*>>& schemes);
+void writeThroughputReport(std::ostream& os, const std::vector<std::pair<char, const MetricsAccumulator*>>& schemes);
+
+// One scheme run under one starvation policy, for the policy comparison
+struct PolicyOutcome {
+    char scheme = 'A';
+    StarvationPolicy policy;
+    MetricsAccumulator metrics;
+};
+// Mean RT and TAT next to the p99 and worst TAT (and worst WT) of every outcome, in order
+void writeStarvationReport(std::ostream& os, const std::vector<PolicyOutcome>& outcomes);
+
 PerformanceMetrics calculateMetrics(const std::vector<Task>& items);
 std::string algorithmDescription(char algorithm);
 void writeConsolidatedReport(std::ostream& os, const std::vector<std::pair<char, std::vector<Task>>>& results);
+void writeConsolidatedReport(std::ostream& os, const std::vector<std::pair<char, std::vector<Task>>>& results,
+                             const ReportOptions& reportOptions);
+void writeStatisticsReport(std::ostream& os, const std::vector<std::pair<char, SchedulerStatistics>>& statistics);
+
+// Streaming simulation: tasks are admitted in arrival order while simulated time
+// advances; each completed task goes to 'onComplete' and its slot is reused, so
+// memory follows the number of live tasks rather than the trace length.
+class OnlineScheduler {
+public:
+    using CompletionHandler = std::function<void(const Task&)>;
+    using SlotCompletionHandler = std::function<void(int slot, const Task&)>; // slot as returned by admit()
+
+    OnlineScheduler(char algorithm, const SimulationOptions& options, CompletionHandler onComplete);
+    OnlineScheduler(char algorithm, const SimulationOptions& options, SlotCompletionHandler onComplete);
+    ~OnlineScheduler();
+    OnlineScheduler(const OnlineScheduler&) = delete;
+    OnlineScheduler& operator=(const OnlineScheduler&) = delete;
+
+    // Simulates up to its arrival first; throws if it arrives before now(). Returns the
+    // task's slot, which is reused by a later admit() once the task has completed
+    int  admit(const Task& task);
+    void advanceTo(int time);      // simulate every time unit before 'time'
+    void finish();                 // run until every admitted task has completed
+    int  now() const;
+    size_t liveTasks() const;      // admitted and not yet completed
+    size_t capacity() const;       // task slots allocated (peak live tasks)
+
+private:
+    struct State;
+    std::unique_ptr<State> state;
+};
+
+// Live scheduler service: any number of producer threads submit() tasks through a
+// bounded lock-free queue; one scheduler thread drains it into an OnlineScheduler
+// and advances time. Each task arrives at the time unit it is taken off the queue
+// (its own arrivalMoment is ignored). With the SIMULATED clock time only moves while
+// there is work, one unit per pass, as fast as the host allows; with WALL each unit
+// lasts 'unitMicroseconds' of real time. Completions go to the handler on the
+// scheduler thread (it must not throw), with the wall time since submit().
+enum class ServiceClock { SIMULATED, WALL };
+struct ServiceOptions {
+    ServiceClock clock = ServiceClock::SIMULATED;
+    int unitMicroseconds = 1000;       // WALL: real time per simulated unit
+    size_t queueCapacity = 1 << 16;    // submissions waiting for the scheduler (rounded up to a power of two)
+    SimulationOptions simulation;      // statistics are written by the scheduler thread; never traced
+};
+struct ServiceCompletion {
+    std::uint64_t ticket = 0;          // as returned by submit()
+    Task task;                         // arrival and finish in simulated units
+    long long latencyNanoseconds = 0;  // submit() to completion, wall time
+};
+class SchedulerService {
+public:
+    using CompletionHandler = std::function<void(const ServiceCompletion&)>;
+
+    SchedulerService(char algorithm, const ServiceOptions& options, CompletionHandler onComplete);
+    ~SchedulerService();  // stop()
+    SchedulerService(const SchedulerService&) = delete;
+    SchedulerService& operator=(const SchedulerService&) = delete;
+
+    // Thread-safe. submit() yields while the queue is full; trySubmit() returns false instead.
+    // Both throw logic_error after stop()
+    std::uint64_t submit(Task task);
+    bool trySubmit(Task& task, std::uint64_t& ticket);  // 'task' is moved from only on success
+
+    // Run every submitted task to completion and join the scheduler thread. Producers
+    // must have returned from their last submit() first
+    void stop();
+
+    int now() const;               // current simulated time unit
+    std::uint64_t submitted() const;
+    std::uint64_t completed() const;
+
+private:
+    struct State;
+    std::unique_ptr<State> state;
+};
+
+// Multi-CPU simulation: one MLFQ level array per CPU, arrivals placed on the
+// least loaded CPU, idle CPUs stealing queued work at every balancing point
+struct MultiCpuOptions {
+    int cpuCount = 1;
+    int migrationCost = 0;     // extra time units a stolen task needs on its new CPU
+    int balanceInterval = 1;   // time units between balancing points (arrivals always balance)
+    unsigned threadCount = 0;  // host threads advancing the CPUs (0: hardware concurrency)
+};
+struct MultiCpuResult {
+    std::vector<Task> tasks;
+    std::vector<long long> busyUnits;  // time units each CPU spent executing
+    long long makespan = 0;            // last completion time
+    long long migrations = 0;          // tasks stolen by an idle CPU
+};
+MultiCpuResult executeMultiCpuMLFQ(const std::vector<Task>& input, char algorithm,
+                                   const MultiCpuOptions& cpus, const SimulationOptions& options);
+void writeUtilizationReport(std::ostream& os, const std::vector<std::pair<char, MultiCpuResult>>& results);
+
+// Quantum/strategy search against one workload: every four-level scheme whose RR
+// quanta do not shrink from level to level, kept on the Pareto front of (mean TAT, p99 TAT)
+struct TuningOptions {
+    std::vector<int> quanta{1, 2, 3, 4, 5, 6, 8, 10, 12, 16, 20}; // RR quanta tried on each level
+    SimulationOptions simulation;  // engine and accounting (statistics are not collected)
+    unsigned threadCount = 0;      // 0: hardware concurrency
+    bool pruning = true;           // stop a candidate once its lower bounds are dominated
+};
+struct TuningCandidate {
+    LevelScheme levels;
+    double meanTurnaround = 0.0;
+    long long p99Turnaround = 0;   // nearest rank, exact
+};
+struct TuningResult {
+    std::vector<TuningCandidate> front;  // ascending mean TAT
+    size_t candidates = 0, pruned = 0;
+    double wallSeconds = 0.0;
+};
+TuningResult tuneSchemes(const std::vector<Task>& workload, const TuningOptions& options);
+TuningResult tuneSchemes(const PreparedWorkload& workload, const TuningOptions& options);
+void writeTuningReport(std::ostream& os, const TuningResult& result);
+
+// Batch execution: (file × scheme) jobs spread over a work-stealing pool,
+// one consolidated report per input written to the output directory
+struct BatchSummary { size_t inputs = 0, jobs = 0, failures = 0; double wallSeconds = 0.0; };
+std::vector<std::string> collectBatchInputs(const std::string& source); // directory (*.txt) or list file
+BatchSummary runBatch(const std::vector<std::string>& inputFiles, const std::string& outputDirectory,
+                      const std::vector<char>& schemes, const SimulationOptions& options,
+                      const ReportOptions& reportOptions, unsigned threadCount);
+
+// Synthetic workloads (seeded, reproducible) in the input file format
+enum class ArrivalPattern { POISSON, BURSTY };        // exponential gaps / clustered arrivals
+enum class BurstDistribution { EXPONENTIAL, PARETO }; // light / heavy-tailed burst times
+struct WorkloadSpec {
+    size_t taskCount = 100;
+    unsigned long long seed = 1;
+    ArrivalPattern arrivals = ArrivalPattern::POISSON;
+    BurstDistribution bursts = BurstDistribution::EXPONENTIAL;
+    double meanInterarrival = 5.0;  // time units between arrivals (long-run mean)
+    double meanBurst = 10.0;        // mean CPU burst
+};
+std::vector<Task> generateWorkload(const WorkloadSpec& spec);
+void writeTaskFile(std::ostream& output, const std::vector<Task>& tasks); // "label; BT; AT; Q; Pr[; bursts]" lines
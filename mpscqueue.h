@@ -0,0 +1,84 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+// =============================================================
+// Bounded lock-free multi-producer, single-consumer ring
+// =============================================================
+//
+// Each cell carries a sequence number: a producer claims the next position
+// with one compare-and-swap on 'tail', fills the cell and publishes it by
+// bumping the cell's sequence; the consumer reads cells in order without
+// atomic read-modify-writes. No locks and no allocation after construction;
+// a full ring makes tryPush() fail instead of waiting.
+template <class T>
+class MpscRing {
+    struct alignas(64) Cell {
+        std::atomic<std::size_t> sequence;
+        T value;
+    };
+
+    std::unique_ptr<Cell[]> cells;
+    std::size_t mask;
+    alignas(64) std::atomic<std::size_t> tail{0};  // next position to claim (producers)
+    alignas(64) std::size_t head = 0;              // next position to read (consumer)
+
+    static std::size_t roundUp(std::size_t capacity) {
+        std::size_t size = 2;
+        while (size < capacity) size <<= 1;
+        return size;
+    }
+
+public:
+    explicit MpscRing(std::size_t capacity)  // rounded up to a power of two
+        : cells(new Cell[roundUp(capacity)]), mask(roundUp(capacity) - 1) {
+        for (std::size_t position = 0; position <= mask; ++position)
+            cells[position].sequence.store(position, std::memory_order_relaxed);
+    }
+
+    MpscRing(const MpscRing&) = delete;
+    MpscRing& operator=(const MpscRing&) = delete;
+
+    std::size_t capacity() const { return mask + 1; }
+    std::size_t claimed() const { return tail.load(std::memory_order_relaxed); }  // positions handed out so far
+
+    // Any thread; false when the ring is full ('value' is left untouched). 'position' is
+    // the value's place in the order the consumer sees: 0, 1, 2, ... with no gaps
+    bool tryPush(T& value, std::size_t& position) {
+        position = tail.load(std::memory_order_relaxed);
+        while (true) {
+            Cell& cell = cells[position & mask];
+            std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            auto difference = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position);
+            if (difference == 0) {
+                if (tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    cell.value = std::move(value);
+                    cell.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (difference < 0) {
+                return false;  // the consumer has not freed this cell yet
+            } else {
+                position = tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Consumer thread only; false when nothing is published at the head
+    bool tryPop(T& value) {
+        Cell& cell = cells[head & mask];
+        if (cell.sequence.load(std::memory_order_acquire) != head + 1) return false;
+        value = std::move(cell.value);
+        cell.sequence.store(head + mask + 1, std::memory_order_release);
+        ++head;
+        return true;
+    }
+
+    // Consumer thread only
+    bool empty() const {
+        return cells[head & mask].sequence.load(std::memory_order_acquire) != head + 1;
+    }
+};
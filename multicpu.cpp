@@ -0,0 +1,180 @@
+#include "mlfq.h"
+#include "engine.h"
+#include "levels.h"
+#include "pipeline.h"
+#include "pool.h"
+#include <algorithm>
+#include <cctype>
+#include <iomanip>
+#include <ostream>
+#include <stdexcept>
+
+using namespace std;
+
+// Multi-CPU MLFQ: one level array and one MLFQCore per CPU over a shared task table.
+//
+// Time is cut into epochs that end at the next arrival or after balanceInterval
+// units. At an epoch start (serially) arrivals go to the least loaded CPU and
+// every idle CPU steals one queued task from the most loaded CPU; tasks back from
+// I/O rejoin the CPU they blocked on. Inside an epoch the CPUs never interact, so
+// contiguous groups of CPUs advance on separate host threads, and results do not
+// depend on the thread count.
+
+namespace {
+    template <class Levels>
+    struct Cpu {
+        Levels levels;
+        SchedulerStatistics statistics;
+        ExecutionTrace trace;
+        unique_ptr<MLFQCore<Levels>> core;
+    };
+
+    template <class Levels, class MakeLevels>
+    MultiCpuResult simulateCpus(const vector<Task>& input, const MultiCpuOptions& setup,
+                                const SimulationOptions& options, MakeLevels makeLevels){
+        TaskTable taskTable(input); // interned identifiers, all tasks reset to level 1
+        const int cpuCount = max(1, setup.cpuCount);
+        const int balanceInterval = max(1, setup.balanceInterval);
+
+        // Per-CPU statistics and traces are merged at the end: cores never share a recorder
+        vector<unique_ptr<Cpu<Levels>>> cpus;
+        for (int i = 0; i < cpuCount; ++i){
+            auto cpu = unique_ptr<Cpu<Levels>>(new Cpu<Levels>{makeLevels(taskTable), SchedulerStatistics{}, ExecutionTrace(i), nullptr});
+            SimulationOptions cpuOptions = options;
+            cpuOptions.statistics = options.statistics ? &cpu->statistics : nullptr;
+            cpuOptions.trace = options.trace ? &cpu->trace : nullptr;
+            cpu->core = make_unique<MLFQCore<Levels>>(taskTable, cpu->levels, cpuOptions);
+            cpus.push_back(move(cpu));
+        }
+
+        // Contiguous CPU groups, one pool job each per epoch
+        unique_ptr<WorkStealingPool> pool;
+        if (cpuCount > 1 && setup.threadCount != 1) pool = make_unique<WorkStealingPool>(setup.threadCount);
+        const int groups = pool ? min<int>(cpuCount, static_cast<int>(pool->size())) : 1;
+        const int usedGroups = max(1, groups);
+
+        MultiCpuResult result;
+        const vector<int> arrivalSequence = arrivalOrder(taskTable);
+        size_t nextArrivalIndex = 0;
+        int currentTime = 0;
+
+        auto completedTasks = [&]{
+            int total = 0;
+            for (const auto& cpu : cpus) total += cpu->core->completedTasks();
+            return total;
+        };
+        auto advanceGroup = [&](int group, int epochEnd){
+            int first = cpuCount * group / usedGroups, last = cpuCount * (group + 1) / usedGroups;
+            for (int i = first; i < last; ++i){
+                auto& core = *cpus[i]->core;
+                for (int now = currentTime; now < epochEnd; ) now += core.advance(now, epochEnd);
+            }
+        };
+
+        while (completedTasks() < taskTable.size()){
+            // Arrivals: least loaded CPU, lowest index on ties
+            while (nextArrivalIndex < arrivalSequence.size() && taskTable.arrivalMoment[arrivalSequence[nextArrivalIndex]] == currentTime){
+                int target = 0;
+                for (int i = 1; i < cpuCount; ++i)
+                    if (cpus[i]->core->load() < cpus[target]->core->load()) target = i;
+                cpus[target]->core->admit(arrivalSequence[nextArrivalIndex], currentTime);
+                ++nextArrivalIndex;
+            }
+
+            // Work stealing: each idle CPU takes one queued task from the most loaded CPU
+            bool anyBusy = false;
+            for (int thief = 0; thief < cpuCount; ++thief){
+                if (!cpus[thief]->core->idle()) { anyBusy = true; continue; }
+                int victim = -1, victimQueue = 0;
+                for (int i = 0; i < cpuCount; ++i){
+                    int queued = cpus[i]->core->queuedTasks();
+                    if (i != thief && queued > victimQueue) { victim = i; victimQueue = queued; }
+                }
+                if (victim == -1) continue;
+                int taskId = cpus[victim]->core->surrender(currentTime);
+                if (taskId == -1) continue;
+                taskTable.timeLeft[taskId] += max(0, setup.migrationCost);
+                taskTable.burstLeft[taskId] += max(0, setup.migrationCost);
+                cpus[thief]->core->admit(taskId, currentTime);
+                ++result.migrations;
+                anyBusy = true;
+            }
+
+            int nextArrival = nextArrivalIndex < arrivalSequence.size()
+                ? taskTable.arrivalMoment[arrivalSequence[nextArrivalIndex]] : MLFQCore<Levels>::NO_HORIZON;
+            if (!anyBusy){
+                // Every CPU idle: skip to the next arrival or I/O completion
+                int nextEvent = nextArrival;
+                for (const auto& cpu : cpus) nextEvent = min(nextEvent, cpu->core->nextWakeUp());
+                if (nextEvent != MLFQCore<Levels>::NO_HORIZON && nextEvent > currentTime){
+                    currentTime = nextEvent;
+                    continue;
+                }
+            }
+            int epochEnd = static_cast<int>(min<long long>(static_cast<long long>(currentTime) + balanceInterval, nextArrival));
+
+            if (usedGroups == 1){
+                advanceGroup(0, epochEnd);
+            } else {
+                for (int group = 0; group < usedGroups; ++group)
+                    pool->submit([&advanceGroup, group, epochEnd]{ advanceGroup(group, epochEnd); });
+                pool->wait();
+            }
+            currentTime = epochEnd;
+        }
+
+        result.tasks = taskTable.toTasks();
+        for (const auto& task : result.tasks) result.makespan = max<long long>(result.makespan, task.finishMoment);
+        for (const auto& cpu : cpus){
+            result.busyUnits.push_back(cpu->core->busyUnits());
+            if (options.trace) options.trace->append(cpu->trace);
+            if (!options.statistics) continue;
+            auto& levels = options.statistics->levels;
+            if (levels.size() < cpu->statistics.levels.size()) levels.resize(cpu->statistics.levels.size());
+            for (size_t level = 0; level < cpu->statistics.levels.size(); ++level){
+                auto& total = levels[level];
+                const auto& counters = cpu->statistics.levels[level];
+                total.dispatches += counters.dispatches;
+                total.demotions += counters.demotions;
+                total.preemptions += counters.preemptions;
+                total.promotions += counters.promotions;
+                for (size_t bucket = 0; bucket < total.queueLengthHistogram.size(); ++bucket)
+                    total.queueLengthHistogram[bucket] += counters.queueLengthHistogram[bucket];
+            }
+        }
+        return result;
+    }
+
+    template <class Pipeline>
+    MultiCpuResult simulatePipelineCpus(const vector<Task>& input, const MultiCpuOptions& setup, const SimulationOptions& options){
+        return simulateCpus<Pipeline>(input, setup, options, [](TaskTable& taskTable){ return Pipeline(taskTable); });
+    }
+}
+
+MultiCpuResult executeMultiCpuMLFQ(const vector<Task>& input, char algorithmType,
+                                   const MultiCpuOptions& setup, const SimulationOptions& options){
+    if (options.dispatch == DispatchMode::STATIC && hasStaticPipeline(algorithmType)){
+        switch (toupper(algorithmType)){
+            case 'A': return simulatePipelineCpus<PipelineA>(input, setup, options);
+            case 'B': return simulatePipelineCpus<PipelineB>(input, setup, options);
+            case 'C': return simulatePipelineCpus<PipelineC>(input, setup, options);
+        }
+    }
+    const auto scheme = defineAlgorithmScheme(algorithmType);
+    return simulateCpus<DynamicLevels>(input, setup, options,
+        [&scheme](TaskTable& taskTable){ return DynamicLevels(scheme, taskTable); });
+}
+
+void writeUtilizationReport(ostream& output, const vector<pair<char, MultiCpuResult>>& results){
+    output << "\n🖥️ CPU Utilization\n";
+    output << "algorithm; CPUs; makespan; migrations; busy % per CPU\n";
+    for (const auto& entry : results){
+        const auto& result = entry.second;
+        output << entry.first << "; " << result.busyUnits.size() << "; " << result.makespan << "; " << result.migrations << ";";
+        for (long long busy : result.busyUnits){
+            double share = result.makespan > 0 ? 100.0 * static_cast<double>(busy) / static_cast<double>(result.makespan) : 0.0;
+            output << ' ' << fixed << setprecision(1) << share;
+        }
+        output << '\n';
+    }
+}
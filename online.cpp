@@ -0,0 +1,196 @@
+#include "mlfq.h"
+#include "engine.h"
+#include "levels.h"
+#include <algorithm>
+#include <climits>
+#include <map>
+#include <stdexcept>
+
+using namespace std;
+
+// Streaming MLFQ over a task table of recycled slots
+
+namespace {
+    // Slots are recycled, so slot numbers in a trace would not name tasks: streams are never traced
+    SimulationOptions untraced(SimulationOptions options){
+        options.trace = nullptr;
+        return options;
+    }
+
+    // Integer labels that follow the lexicographic order of the live identifiers,
+    // so the engine's identifier tie-breaks keep comparing integers. New names take
+    // a label between their neighbours; when a gap runs out only the smallest
+    // enclosing label range that is still sparse enough is renumbered (relative
+    // order, and so every queue invariant, is kept), amortized O(log n) names.
+    class IdentifierLabels {
+        struct Entry { int label; unsigned long long born; vector<int> slots; };  // slots: tasks bearing the name
+        map<string, Entry> live;
+        unsigned long long names = 0;  // names placed so far: age order of the entries
+
+    public:
+        using Handle = map<string, Entry>::iterator;  // stays valid until its last release()
+
+    private:
+
+        static constexpr long long lowest = INT_MIN + 1LL, highest = INT_MAX - 1LL;
+        static constexpr long long appendStep = 1LL << 16; // room left for later names at either end
+        static constexpr long long runShare = 16;          // a name next to a newer neighbour takes 1/16 of the gap
+        static constexpr double rangeGrowth = 1.6;         // an aligned range of 2^i labels may hold 1.6^i names
+
+        // Label strictly between the neighbours of 'position', or false when they are adjacent
+        bool place(Handle position){
+            long long below = lowest - 1, above = highest + 1;
+            if (position != live.begin()) below = prev(position)->second.label;
+            if (next(position) != live.end()) above = next(position)->second.label;
+            if (above - below < 2) return false;
+            // Runs like T50000, T50001, ... land next to the previous name of the run, the newer
+            // neighbour: stepping off it instead of halving leaves room for the rest of the run
+            long long step = max(1LL, (above - below) / runShare);
+            bool first = position == live.begin(), last = next(position) == live.end();
+            long long label = below + (above - below) / 2;
+            if (first && !last) label = above - min(step, appendStep);
+            else if (last && !first) label = below + min(step, appendStep);
+            else if (!first && !last) label = prev(position)->second.born > next(position)->second.born ? below + step : above - step;
+            position->second.label = static_cast<int>(label);
+            return true;
+        }
+
+        // 'position' found no gap: grow an aligned range of labels around its neighbour until
+        // the names inside (it included) are few enough for the range's size, then space them
+        // evenly there. Larger ranges must be emptier, so a crowded spot is spread over a
+        // range sized to it and the next insertions nearby find gaps again. Calls
+        // moved(slot) for every slot of the other names whose label changed.
+        template <class Moved>
+        void relabel(Handle position, Moved&& moved){
+            const long long span = highest - lowest + 1;
+            long long offset = (position != live.begin() ? prev(position) : next(position))->second.label - lowest;
+            Handle first = position, last = position;
+            long long count = 1, start = 0, end = span;
+            double capacity = 1;
+            for (int bits = 1; (1LL << bits) < span; ++bits){
+                capacity *= rangeGrowth;
+                long long rangeStart = offset >> bits << bits, rangeEnd = min(rangeStart + (1LL << bits), span);
+                while (first != live.begin() && prev(first)->second.label - lowest >= rangeStart) { --first; ++count; }
+                while (next(last) != live.end() && next(last)->second.label - lowest < rangeEnd) { ++last; ++count; }
+                if (count <= capacity) { start = rangeStart; end = rangeEnd; break; }
+            }
+            if (end - start == span) { first = live.begin(); last = prev(live.end()); count = static_cast<long long>(live.size()); }
+
+            long long spacing = (end - start) / count, label = lowest + start + spacing / 2;
+            for (Handle entry = first; ; ++entry, label += spacing){
+                bool changed = entry->second.label != label && entry != position;
+                entry->second.label = static_cast<int>(label);
+                if (changed) for (int slot : entry->second.slots) moved(slot);
+                if (entry == last) break;
+            }
+        }
+
+    public:
+        // 'slot' now holds a task named 'identifier'; moved(slot) is called for the slots of other
+        // names whose label changed (callers refresh their copies)
+        template <class Moved>
+        void acquire(const string& identifier, int slot, Handle& handle, Moved&& moved){
+            auto inserted = live.emplace(identifier, Entry{0, names++, {}});
+            handle = inserted.first;
+            handle->second.slots.push_back(slot);
+            if (inserted.second && !place(handle)) relabel(handle, moved);
+        }
+
+        void release(Handle handle, int slot){
+            vector<int>& slots = handle->second.slots;
+            slots.erase(find(slots.begin(), slots.end(), slot));
+            if (slots.empty()) live.erase(handle);
+        }
+
+        static int labelOf(Handle handle) { return handle->second.label; }
+    };
+}
+
+struct OnlineScheduler::State {
+    vector<Task> records;   // report records per slot, bound to the table
+    vector<char> occupied;  // slot holds a live (or staged) task
+    vector<IdentifierLabels::Handle> labelOfSlot;  // occupied slots only
+    TaskTable table;
+    DynamicLevels levels;
+    MLFQCore<DynamicLevels> core;
+    IdentifierLabels labels;
+    vector<int> freeSlots;
+    vector<int> staged;     // slots arriving at 'now', admitted when 'now' is simulated
+    int now = 0;
+    size_t live = 0;
+    SlotCompletionHandler onComplete;
+
+    State(char algorithm, const SimulationOptions& options, SlotCompletionHandler handler)
+        : levels(defineAlgorithmScheme(algorithm), table), core(table, levels, untraced(options)), onComplete(move(handler)) {
+        table.bind(records);
+    }
+
+    // Arrivals at 'now' enter level 1 in identifier order (ties: input order), as in the batch engine
+    void admitStaged(){
+        if (staged.empty()) return;
+        stable_sort(staged.begin(), staged.end(), [&](int x, int y){ return table.identifierRank[x] < table.identifierRank[y]; });
+        for (int slot : staged) core.admit(slot, now);
+        live += staged.size();
+        staged.clear();
+    }
+
+    void step(int horizon){
+        admitStaged();
+        now += core.advance(now, horizon);
+        int finished = core.lastCompletedTask();
+        if (finished == -1) return;
+        onComplete(finished, table.task(finished));
+        labels.release(labelOfSlot[finished], finished);
+        records[finished] = Task{};
+        occupied[finished] = 0;
+        freeSlots.push_back(finished);
+        --live;
+    }
+};
+
+OnlineScheduler::OnlineScheduler(char algorithm, const SimulationOptions& options, SlotCompletionHandler onComplete)
+    : state(make_unique<State>(algorithm, options, move(onComplete))) {}
+
+OnlineScheduler::OnlineScheduler(char algorithm, const SimulationOptions& options, CompletionHandler onComplete)
+    : OnlineScheduler(algorithm, options, SlotCompletionHandler([handler = move(onComplete)](int, const Task& task){ handler(task); })) {}
+
+OnlineScheduler::~OnlineScheduler() = default;
+
+int OnlineScheduler::admit(const Task& task){
+    State& s = *state;
+    if (task.arrivalMoment < s.now)
+        throw runtime_error("❌ Task '" + task.identifier + "' arrives at " + to_string(task.arrivalMoment)
+                            + ", before the current time " + to_string(s.now) + " (input must be in arrival order)");
+    advanceTo(task.arrivalMoment);
+
+    int slot;
+    if (!s.freeSlots.empty()) { slot = s.freeSlots.back(); s.freeSlots.pop_back(); }
+    else { slot = s.table.size(); s.records.emplace_back(); s.occupied.push_back(0); s.labelOfSlot.emplace_back(); }
+    s.records[slot] = task;
+    s.occupied[slot] = 1;
+
+    s.labels.acquire(task.identifier, slot, s.labelOfSlot[slot], [&](int other){
+        s.table.identifierRank[other] = IdentifierLabels::labelOf(s.labelOfSlot[other]);
+        s.levels.refreshRank(other);
+    });
+    s.table.assign(slot, task, IdentifierLabels::labelOf(s.labelOfSlot[slot]));
+    s.staged.push_back(slot);
+    return slot;
+}
+
+void OnlineScheduler::advanceTo(int time){
+    State& s = *state;
+    while (s.now < time){
+        if (s.live == 0 && s.staged.empty()) { s.now = time; break; } // nothing to run: jump
+        s.step(time);
+    }
+}
+
+void OnlineScheduler::finish(){
+    State& s = *state;
+    while (s.live > 0 || !s.staged.empty()) s.step(MLFQCore<DynamicLevels>::NO_HORIZON);
+}
+
+int OnlineScheduler::now() const { return state->now; }
+size_t OnlineScheduler::liveTasks() const { return state->live + state->staged.size(); }
+size_t OnlineScheduler::capacity() const { return static_cast<size_t>(state->table.size()); }
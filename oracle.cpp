@@ -0,0 +1,417 @@
+#include "mlfq.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <new>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Differential oracle for the schedulers. Three checks, exit status 1 if any fails:
+//  1. golden: every inputs/*.txt through A, B and C must reproduce outputs/*.txt byte for byte;
+//  2. allocations: a warm SimulationContext re-running the same input must not allocate;
+//  3. differential: random workloads (and the golden inputs) go through the reference
+//     executeMLFQ (tick engine, per-tick accounting, dynamic levels, the variant's
+//     starvation policy) and through every variant below; a diverging workload is
+//     shrunk to a minimal reproducer.
+//
+//   oracle [--inputs=DIR] [--outputs=DIR] [--rounds=N] [--seed=S] [--tasks=N] [--repro=FILE]
+//
+// New engines or strategies are checked by adding a row to variants().
+
+using namespace std;
+namespace fs = std::filesystem;
+
+// Every heap allocation in the process goes through here (counted for check 2)
+static atomic<size_t> allocationCount{0};
+
+void* operator new(size_t size){
+    ++allocationCount;
+    if (void* memory = malloc(size ? size : 1)) return memory;
+    throw bad_alloc();
+}
+void operator delete(void* memory) noexcept { free(memory); }
+void operator delete(void* memory, size_t) noexcept { free(memory); }
+
+namespace {
+    using Runner = function<vector<Task>(const vector<Task>&, char)>;
+    struct Variant { string name; Runner run; StarvationPolicy policy; }; // the reference runs under 'policy' too
+
+    // Short enough to fire many times in the small random workloads
+    const StarvationPolicy boostAndAging{7, 3}, boostOnly{5, 0}, agingOnly{0, 2};
+
+    SimulationOptions withPolicy(const StarvationPolicy& policy){
+        SimulationOptions options;
+        options.starvation = policy;
+        return options;
+    }
+
+    Runner simulation(EngineMode engine, WaitAccounting accounting, DispatchMode dispatch, const StarvationPolicy& policy = {}){
+        SimulationOptions options = withPolicy(policy);
+        options.engine = engine;
+        options.waitAccounting = accounting;
+        options.dispatch = dispatch;
+        return [options](const vector<Task>& tasks, char scheme){ return executeMLFQ(tasks, scheme, options); };
+    }
+
+    // Runner for one of the run* functions below under 'policy'
+    Runner underPolicy(vector<Task> (*run)(const vector<Task>&, char, const SimulationOptions&), const StarvationPolicy& policy){
+        SimulationOptions options = withPolicy(policy);
+        return [run, options](const vector<Task>& tasks, char scheme){ return run(tasks, scheme, options); };
+    }
+
+    // Streaming mode needs arrival order; a stable sort keeps input order among equal arrivals
+    vector<Task> runStreaming(const vector<Task>& tasks, char scheme, const SimulationOptions& options){
+        vector<Task> ordered(tasks), completed;
+        stable_sort(ordered.begin(), ordered.end(), [](const Task& a, const Task& b){ return a.arrivalMoment < b.arrivalMoment; });
+        OnlineScheduler scheduler(scheme, options, [&](const Task& task){ completed.push_back(task); });
+        for (const auto& task : ordered) scheduler.admit(task);
+        scheduler.finish();
+        return completed;
+    }
+
+    // One context for every call, so runs of all sizes, schemes and policies follow each other on it
+    vector<Task> runInContext(const vector<Task>& tasks, char scheme, const SimulationOptions& options){
+        static SimulationContext context;
+        return context.run(tasks, scheme, options);
+    }
+
+    // Prepared once, then run on the shared context from a copy of the prepared table
+    vector<Task> runPrepared(const vector<Task>& tasks, char scheme, const SimulationOptions& options){
+        static SimulationContext context;
+        const PreparedWorkload workload(tasks);
+        return context.run(workload, scheme, options);
+    }
+
+    // Baseline stopped half way, written out, read back into a fresh simulation and resumed
+    vector<Task> runResumed(const vector<Task>& tasks, char scheme, const SimulationOptions& options){
+        int span = 0;
+        for (const auto& task : tasks) span = max(span, task.arrivalMoment + task.serviceDuration);
+        CheckpointedSimulation first(scheme, options, 2);
+        first.run(tasks, span / 2);
+        stringstream file;
+        first.save(file);
+        CheckpointedSimulation second(scheme, options, 2);
+        second.load(tasks, file);
+        return second.resume();
+    }
+
+    // Baseline with the last row's arrival and burst changed, then the actual tasks as a what-if
+    vector<Task> runWhatIf(const vector<Task>& tasks, char scheme){
+        vector<Task> baseline(tasks);
+        Task& changed = baseline.back();
+        changed.arrivalMoment += 2;
+        if (changed.bursts.empty()) changed.serviceDuration += 3;
+        else changed.bursts.front() += 3, changed.serviceDuration += 3;
+        SimulationOptions options;
+        options.engine = EngineMode::EVENT;
+        options.waitAccounting = WaitAccounting::TIMESTAMP;
+        CheckpointedSimulation simulation(scheme, options, 3);
+        simulation.run(baseline);
+        return simulation.whatIf(tasks);
+    }
+
+    vector<Task> runSingleCpu(const vector<Task>& tasks, char scheme, const SimulationOptions& options){
+        MultiCpuOptions cpus;
+        cpus.threadCount = 1;
+        return executeMultiCpuMLFQ(tasks, scheme, cpus, options).tasks;
+    }
+
+    const vector<Variant>& variants(){
+        static const vector<Variant> registered{
+            {"tick/timestamp",        simulation(EngineMode::TICK,  WaitAccounting::TIMESTAMP, DispatchMode::DYNAMIC), {}},
+            {"event/per-tick",        simulation(EngineMode::EVENT, WaitAccounting::PER_TICK,  DispatchMode::DYNAMIC), {}},
+            {"event/timestamp",       simulation(EngineMode::EVENT, WaitAccounting::TIMESTAMP, DispatchMode::DYNAMIC), {}},
+            {"static/tick",           simulation(EngineMode::TICK,  WaitAccounting::PER_TICK,  DispatchMode::STATIC), {}},
+            {"static/event",          simulation(EngineMode::EVENT, WaitAccounting::TIMESTAMP, DispatchMode::STATIC), {}},
+            {"multicpu(1)",           underPolicy(runSingleCpu, {}), {}},
+            {"stream",                underPolicy(runStreaming, {}), {}},
+            {"context",               underPolicy(runInContext, {}), {}},
+            {"prepared",              underPolicy(runPrepared, {}), {}},
+            {"checkpoint/resume",     underPolicy(runResumed, {}), {}},
+            {"checkpoint/what-if",    runWhatIf, {}},
+            {"boost+aging tick/timestamp",  simulation(EngineMode::TICK,  WaitAccounting::TIMESTAMP, DispatchMode::DYNAMIC, boostAndAging), boostAndAging},
+            {"boost+aging event/per-tick",  simulation(EngineMode::EVENT, WaitAccounting::PER_TICK,  DispatchMode::DYNAMIC, boostAndAging), boostAndAging},
+            {"boost+aging event/timestamp", simulation(EngineMode::EVENT, WaitAccounting::TIMESTAMP, DispatchMode::DYNAMIC, boostAndAging), boostAndAging},
+            {"boost+aging static/event",    simulation(EngineMode::EVENT, WaitAccounting::TIMESTAMP, DispatchMode::STATIC,  boostAndAging), boostAndAging},
+            {"boost event/timestamp",       simulation(EngineMode::EVENT, WaitAccounting::TIMESTAMP, DispatchMode::DYNAMIC, boostOnly),     boostOnly},
+            {"aging event/timestamp",       simulation(EngineMode::EVENT, WaitAccounting::TIMESTAMP, DispatchMode::DYNAMIC, agingOnly),     agingOnly},
+            {"boost+aging multicpu(1)",     underPolicy(runSingleCpu, boostAndAging), boostAndAging},
+            {"boost+aging stream",          underPolicy(runStreaming, boostAndAging), boostAndAging},
+            {"boost+aging context",         underPolicy(runInContext, boostAndAging), boostAndAging},
+            {"boost+aging checkpoint/resume", underPolicy(runResumed, boostAndAging), boostAndAging},
+        };
+        return registered;
+    }
+
+    vector<Task> runReference(const vector<Task>& tasks, char scheme, const StarvationPolicy& policy = {}){
+        return executeMLFQ(tasks, scheme, withPolicy(policy));
+    }
+
+    // Report rows in a canonical order, so engines may return tasks in any order
+    vector<string> reportRows(const vector<Task>& tasks){
+        vector<string> rows;
+        rows.reserve(tasks.size());
+        ostringstream row;
+        for (const auto& task : tasks){
+            row.str("");
+            writeTaskLine(row, task);
+            rows.push_back(row.str());
+            rows.back().pop_back(); // trailing '\n'
+        }
+        sort(rows.begin(), rows.end());
+        return rows;
+    }
+
+    // Empty when the variant agrees with the reference, otherwise the first differing row
+    string divergence(const Variant& variant, const vector<Task>& tasks, char scheme){
+        vector<string> expected, actual;
+        try {
+            expected = reportRows(runReference(tasks, scheme, variant.policy));
+            actual = reportRows(variant.run(tasks, scheme));
+        } catch (const exception& error){
+            return string("threw: ") + error.what();
+        }
+        if (expected.size() != actual.size())
+            return to_string(actual.size()) + " tasks reported, expected " + to_string(expected.size());
+        auto mismatch = std::mismatch(expected.begin(), expected.end(), actual.begin());
+        if (mismatch.first == expected.end()) return "";
+        return "expected '" + *mismatch.first + "', got '" + *mismatch.second + "'";
+    }
+
+    // Greedy shrinking: drop tasks and I/O, then pull bursts and arrivals towards their minimum,
+    // keeping each step only if the variant still diverges; repeat until nothing helps
+    vector<Task> shrink(vector<Task> tasks, const Variant& variant, char scheme){
+        auto fails = [&](const vector<Task>& candidate){ return !divergence(variant, candidate, scheme).empty(); };
+        auto tryReplace = [&](vector<Task>& current, vector<Task> candidate){
+            if (!fails(candidate)) return false;
+            current = move(candidate);
+            return true;
+        };
+        bool progress = true;
+        while (progress){
+            progress = false;
+            for (size_t index = tasks.size(); index-- > 0 && tasks.size() > 1; ){
+                vector<Task> candidate(tasks);
+                candidate.erase(candidate.begin() + static_cast<ptrdiff_t>(index));
+                progress |= tryReplace(tasks, move(candidate));
+            }
+            for (size_t index = 0; index < tasks.size(); ++index){
+                if (tasks[index].bursts.empty()) continue;
+                vector<Task> candidate(tasks);
+                candidate[index].bursts.clear();
+                progress |= tryReplace(tasks, move(candidate));
+            }
+            for (size_t index = 0; index < tasks.size(); ++index){
+                const int lowest[] = {1, 0};
+                int Task::* fields[] = {&Task::serviceDuration, &Task::arrivalMoment};
+                for (int f = tasks[index].bursts.empty() ? 0 : 1; f < 2; ++f){ // BT is fixed by the bursts
+                    int value = tasks[index].*fields[f];
+                    for (int target : {lowest[f], lowest[f] + (value - lowest[f]) / 2, value - 1}){
+                        if (target < lowest[f] || target >= value) continue;
+                        vector<Task> candidate(tasks);
+                        candidate[index].*fields[f] = target;
+                        candidate[index].timeLeft = candidate[index].serviceDuration;
+                        if (tryReplace(tasks, move(candidate))){ progress = true; break; }
+                    }
+                }
+            }
+        }
+        return tasks;
+    }
+
+    // Small bursts and dense arrivals, so ties, preemptions and idle gaps are common
+    vector<Task> randomWorkload(mt19937_64& random, size_t maxTasks){
+        size_t count = uniform_int_distribution<size_t>(1, maxTasks)(random);
+        int maxBurst = uniform_int_distribution<int>(1, 40)(random);
+        int maxGap = uniform_int_distribution<int>(0, 8)(random);
+        vector<Task> tasks(count);
+        int clock = 0;
+        for (size_t i = 0; i < count; ++i){
+            Task& task = tasks[i];
+            task.identifier = string(1, static_cast<char>('A' + i % 26)) + (i >= 26 ? to_string(i / 26) : "");
+            task.serviceDuration = uniform_int_distribution<int>(1, maxBurst)(random);
+            clock += uniform_int_distribution<int>(0, maxGap)(random);
+            task.arrivalMoment = clock;
+            task.tier = uniform_int_distribution<int>(1, 4)(random);
+            task.priority = uniform_int_distribution<int>(1, 5)(random);
+            task.timeLeft = task.serviceDuration;
+            // Some tasks alternate CPU and I/O: split BT into CPU bursts with I/O between them
+            if (task.serviceDuration > 1 && random() % 3 == 0){
+                int cpuLeft = task.serviceDuration;
+                while (cpuLeft > 0){
+                    int cpu = uniform_int_distribution<int>(1, cpuLeft)(random);
+                    if (!task.bursts.empty()) task.bursts.push_back(uniform_int_distribution<int>(1, 10)(random));
+                    task.bursts.push_back(cpu);
+                    cpuLeft -= cpu;
+                }
+                if (task.bursts.size() == 1) task.bursts.clear();
+            }
+        }
+        // Out-of-order input rows as well (streaming sorts its own copy)
+        if (random() % 4 == 0) shuffle(tasks.begin(), tasks.end(), random);
+        return tasks;
+    }
+
+    // Usually four levels like A/B/C; otherwise any depth up to MAX_LEVELS, shallow ones more often
+    LevelScheme randomScheme(mt19937_64& random){
+        int depth = 4;
+        switch (random() % 4){
+            case 0: depth = uniform_int_distribution<int>(1, 8)(random); break;
+            case 1: depth = uniform_int_distribution<int>(1, MAX_LEVELS)(random); break;
+        }
+        LevelScheme levels(depth);
+        for (auto& level : levels){
+            switch (random() % 4){
+                case 0:  level = {SchedulingMode::SHORTEST_FIRST, 0}; break;
+                case 1:  level = {SchedulingMode::SHORTEST_REMAINING, 0}; break;
+                default: level = {SchedulingMode::ROUND_ROBIN, uniform_int_distribution<int>(1, 8)(random)}; break;
+            }
+        }
+        return levels;
+    }
+
+    string consolidatedReport(const string& inputPath){
+        auto tasks = parseInputFile(inputPath);
+        vector<pair<char, vector<Task>>> results;
+        for (char scheme : {'A', 'B', 'C'}) results.emplace_back(scheme, runReference(tasks, scheme));
+        ostringstream report;
+        writeConsolidatedReport(report, results);
+        return report.str();
+    }
+
+    string readFile(const fs::path& path){
+        ifstream file(path, ios::binary);
+        return string(istreambuf_iterator<char>(file), istreambuf_iterator<char>());
+    }
+
+    size_t checkGolden(const fs::path& inputs, const fs::path& outputs){
+        vector<fs::path> files;
+        for (const auto& entry : fs::directory_iterator(inputs))
+            if (entry.is_regular_file() && entry.path().extension() == ".txt") files.push_back(entry.path());
+        sort(files.begin(), files.end());
+
+        size_t failures = 0;
+        for (const auto& input : files){
+            fs::path golden = outputs / input.filename();
+            string verdict = "ok";
+            try {
+                if (!fs::exists(golden)) verdict = "no golden file";
+                else if (consolidatedReport(input.string()) != readFile(golden)) verdict = "report differs";
+                else {
+                    auto tasks = parseInputFile(input.string());
+                    for (const auto& variant : variants())
+                        for (char scheme : {'A', 'B', 'C'})
+                            if (!divergence(variant, tasks, scheme).empty())
+                                verdict = variant.name + " diverges on " + string(1, scheme);
+                }
+            } catch (const exception& error){
+                verdict = error.what();
+            }
+            if (verdict != "ok") ++failures;
+            printf("golden  %-14s %s\n", input.filename().string().c_str(), verdict.c_str());
+        }
+        return failures;
+    }
+
+    // Second run of the same input on a context, per engine/accounting/dispatch/policy combination,
+    // from the raw tasks and from a prepared workload
+    size_t checkAllocations(const vector<pair<string, vector<Task>>>& workloads){
+        size_t failures = 0;
+        SimulationContext context;
+        for (const auto& workload : workloads){
+            const PreparedWorkload prepared(workload.second);
+            size_t worst = 0;
+            for (auto engine : {EngineMode::TICK, EngineMode::EVENT})
+            for (auto accounting : {WaitAccounting::PER_TICK, WaitAccounting::TIMESTAMP})
+            for (auto dispatch : {DispatchMode::DYNAMIC, DispatchMode::STATIC})
+            for (const auto& policy : {StarvationPolicy{}, boostAndAging})
+            for (char scheme : {'A', 'B', 'C'}){
+                SimulationOptions options = withPolicy(policy);
+                options.engine = engine;
+                options.waitAccounting = accounting;
+                options.dispatch = dispatch;
+                context.run(workload.second, scheme, options);
+                size_t before = allocationCount.load();
+                context.run(workload.second, scheme, options);
+                worst = max(worst, allocationCount.load() - before);
+                before = allocationCount.load();
+                context.run(prepared, scheme, options);
+                worst = max(worst, allocationCount.load() - before);
+            }
+            if (worst) ++failures;
+            printf("allocs  %-14s %s\n", workload.first.c_str(), worst ? (to_string(worst) + " on a warm run").c_str() : "ok");
+        }
+        return failures;
+    }
+}
+
+int main(int argc, char** argv){
+    fs::path inputs = "inputs", outputs = "outputs";
+    string reproPath;
+    unsigned long long seed = 1;
+    size_t rounds = 2000, maxTasks = 12;
+
+    auto hasPrefix = [](const string& text, const char* prefix){
+        return text.compare(0, strlen(prefix), prefix) == 0;
+    };
+    for (int argIndex = 1; argIndex < argc; ++argIndex){
+        string argument = argv[argIndex];
+        string value = argument.substr(argument.find('=') + 1);
+        if (hasPrefix(argument, "--inputs=")) inputs = value;
+        else if (hasPrefix(argument, "--outputs=")) outputs = value;
+        else if (hasPrefix(argument, "--rounds=")) rounds = strtoull(value.c_str(), nullptr, 10);
+        else if (hasPrefix(argument, "--seed=")) seed = strtoull(value.c_str(), nullptr, 10);
+        else if (hasPrefix(argument, "--tasks=")) maxTasks = max<size_t>(1, strtoull(value.c_str(), nullptr, 10));
+        else if (hasPrefix(argument, "--repro=")) reproPath = value;
+        else { cerr << "unknown argument: " << argument << '\n'; return 1; }
+    }
+
+    size_t failures = checkGolden(inputs, outputs);
+
+    // Random schemes run under label 'R', re-registered each round
+    mt19937_64 random(seed);
+
+    vector<pair<string, vector<Task>>> allocationWorkloads;
+    try {
+        allocationWorkloads.emplace_back("mlq001.txt", parseInputFile((inputs / "mlq001.txt").string()));
+    } catch (const exception&) {} // reported by the golden check
+    allocationWorkloads.emplace_back("random", randomWorkload(random, 200));
+    failures += checkAllocations(allocationWorkloads);
+
+    size_t divergences = 0, round = 0;
+    for (; round < rounds && divergences == 0; ++round){
+        auto tasks = randomWorkload(random, maxTasks);
+        registerScheme('R', randomScheme(random));
+        for (const auto& variant : variants()){
+            for (char scheme : {'A', 'B', 'C', 'R'}){
+                if (divergence(variant, tasks, scheme).empty()) continue;
+                auto reproducer = shrink(tasks, variant, scheme);
+                printf("diverge %s, scheme %c (%s), round %zu, seed %llu: %s\n", variant.name.c_str(), scheme,
+                       algorithmDescription(scheme).c_str(), round, seed, divergence(variant, reproducer, scheme).c_str());
+                ostringstream file;
+                writeTaskFile(file, reproducer);
+                fputs(file.str().c_str(), stdout);
+                if (!reproPath.empty()){
+                    ofstream repro(reproPath, ios::binary);
+                    repro << file.str();
+                }
+                ++divergences;
+                break;
+            }
+            if (divergences) break;
+        }
+    }
+    printf("differential: %zu variants, %s after %zu rounds (seed %llu)\n", variants().size(),
+           divergences ? "DIVERGED" : "agree", round, seed);
+    return (failures || divergences) ? 1 : 0;
+}
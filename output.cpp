@@ -1,86 +1,250 @@
 #include "mlfq.h"
+#include "mappedfile.h"
+#include "reportwriter.h"
 #include <fstream>
-#include <sstream>
 #include <iomanip>
 #include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <stdexcept>
 
 using namespace std;
 
-// Utility functions
-static inline string trimWhitespace(const string& text){
-    size_t start = text.find_first_not_of(" \t\r\n");
-    if(start == string::npos) return "";
-    size_t end = text.find_last_not_of(" \t\r\n");
-    return text.substr(start, end - start + 1);
+// Utility functions: in-place tokenizing shared by the stream and mapped parse paths
+static inline bool isBlank(char c){
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
 }
 
-static inline vector<string> splitString(const string& text, char delimiter){
-    vector<string> segments; string fragment; stringstream stream(text);
-    while(getline(stream, fragment, delimiter)) segments.push_back(trimWhitespace(fragment));
-    return segments;
+static inline void trimRange(const char*& begin, const char*& end){
+    while(begin < end && isBlank(*begin)) ++begin;
+    while(end > begin && isBlank(end[-1])) --end;
+}
+
+static int parseNumber(const char* begin, const char* end, size_t lineNumber, const char* fieldName){
+    trimRange(begin, end);
+    if(begin < end && *begin == '+') ++begin;
+    int value = 0;
+    auto [position, error] = from_chars(begin, end, value);
+    if(begin == end || error != errc() || position != end)
+        throw runtime_error("❌ Line " + to_string(lineNumber) + ": invalid " + fieldName + " '" + string(begin, end) + "'");
+    return value;
+}
+
+// Optional sixth field: "CPU,I/O,CPU,...,CPU" burst lengths, all positive, CPU total == BT.
+// A single CPU burst is the plain record.
+static void parseBursts(const char* begin, const char* end, size_t lineNumber, Task& job){
+    trimRange(begin, end);
+    job.bursts.clear();
+    if(begin == end) return;
+    long long cpuTotal = 0;
+    for(const char* cursor = begin; ; ){
+        const char* stop = static_cast<const char*>(memchr(cursor, ',', end - cursor));
+        if(!stop) stop = end;
+        int burst = parseNumber(cursor, stop, lineNumber, job.bursts.size() % 2 ? "I/O burst" : "CPU burst");
+        if(burst <= 0) throw runtime_error("❌ Line " + to_string(lineNumber) + ": bursts must be positive");
+        if(job.bursts.size() % 2 == 0) cpuTotal += burst;
+        job.bursts.push_back(burst);
+        if(stop == end) break;
+        cursor = stop + 1;
+    }
+    if(job.bursts.size() % 2 == 0)
+        throw runtime_error("❌ Line " + to_string(lineNumber) + ": bursts must alternate CPU and I/O and end with a CPU burst");
+    if(cpuTotal != job.serviceDuration)
+        throw runtime_error("❌ Line " + to_string(lineNumber) + ": CPU bursts add up to " + to_string(cpuTotal)
+                            + ", burst time is " + to_string(job.serviceDuration));
+    if(job.bursts.size() == 1) job.bursts.clear();
+}
+
+// Parse one line into 'job'. Returns false for blank and comment lines,
+// throws on malformed records (fewer than 5 fields, bad numbers or bursts).
+static bool parseRecord(const char* begin, const char* end, size_t lineNumber, Task& job){
+    trimRange(begin, end);
+    if(begin == end || *begin == '#') return false; // 🚫 Skip comments
+
+    // Split on ';' like getline: a trailing ';' yields no empty field, extra fields are ignored
+    const char* fieldBegin[6];
+    const char* fieldEnd[6];
+    int fieldCount = 0;
+    for(const char* cursor = begin; fieldCount < 6; ){
+        const char* stop = static_cast<const char*>(memchr(cursor, ';', end - cursor));
+        if(!stop) stop = end;
+        fieldBegin[fieldCount] = cursor; fieldEnd[fieldCount] = stop; ++fieldCount;
+        if(stop == end || stop + 1 == end) break;
+        cursor = stop + 1;
+    }
+    if(fieldCount < 5)
+        throw runtime_error("❌ Line " + to_string(lineNumber) + ": expected 5 ';'-separated fields, found " + to_string(fieldCount));
+
+    const char* labelBegin = fieldBegin[0];
+    const char* labelEnd = fieldEnd[0];
+    trimRange(labelBegin, labelEnd);
+    job.identifier.assign(labelBegin, labelEnd);
+    job.serviceDuration = parseNumber(fieldBegin[1], fieldEnd[1], lineNumber, "burst time");
+    job.arrivalMoment   = parseNumber(fieldBegin[2], fieldEnd[2], lineNumber, "arrival time");
+    job.tier            = parseNumber(fieldBegin[3], fieldEnd[3], lineNumber, "queue");
+    job.priority        = parseNumber(fieldBegin[4], fieldEnd[4], lineNumber, "priority");
+    job.timeLeft = job.serviceDuration;
+    if(fieldCount == 6) parseBursts(fieldBegin[5], fieldEnd[5], lineNumber, job);
+    else job.bursts.clear();
+    return true;
 }
 
 // Internal: parse input stream into task list
 static vector<Task> extractTasks(istream& source){
-    vector<Task> items; string line;
+    vector<Task> items; string line; size_t lineNumber = 0;
     while(getline(source, line)){
-        line = trimWhitespace(line);
-        if(line.empty() || line[0] == '#') continue; // 🚫 Skip comments
-        auto components = splitString(line, ';');
-        if(components.size() < 5) continue;
         Task job;
-        job.identifier     = components[0];
-        job.serviceDuration = stoi(components[1]);
-        job.arrivalMoment  = stoi(components[2]);
-        job.tier         = stoi(components[3]);
-        job.priority        = stoi(components[4]);
-        job.timeLeft = job.serviceDuration;
-        items.push_back(job);
+        if(parseRecord(line.data(), line.data() + line.size(), ++lineNumber, job)) items.push_back(move(job));
+    }
+    return items;
+}
+
+// Internal: parse a whole in-memory buffer (memory-mapped file) without copying lines
+static vector<Task> extractTasks(const char* data, size_t size){
+    vector<Task> items; size_t lineNumber = 0;
+    const char* end = data + size;
+    items.reserve(static_cast<size_t>(count(data, end, '\n')) + 1); // one upfront scan beats regrowth
+    for(const char* cursor = data; cursor < end; ){
+        const char* lineEnd = static_cast<const char*>(memchr(cursor, '\n', end - cursor));
+        if(!lineEnd) lineEnd = end;
+        Task job;
+        if(parseRecord(cursor, lineEnd, ++lineNumber, job)) items.push_back(move(job));
+        cursor = (lineEnd == end) ? end : lineEnd + 1;
     }
     return items;
 }
 
 // Public API functions
 vector<Task> parseInputFile(const string& filepath){
-    ifstream inputFile(filepath);
-    if(!inputFile) throw runtime_error("❌ Unable to open file: " + filepath);
-    return extractTasks(inputFile);
+    MappedFile inputFile(filepath);
+    return extractTasks(inputFile.data(), inputFile.size());
 }
 
 vector<Task> parseInputStream(istream& inputStream){
     return extractTasks(inputStream);
 }
 
-void generateReport(ostream& output, const vector<Task>& taskList){
-    long long totalWT = 0, totalCT = 0, totalRT = 0, totalTAT = 0;
-    for (const auto& task : taskList){
-        int responseTime  = (task.startMoment < 0 ? 0 : (task.startMoment));
-        int turnaroundTime = (task.finishMoment < 0 ? 0 : (task.finishMoment - task.arrivalMoment));
-        totalWT += task.delayAccumulated; totalCT += task.finishMoment; totalRT += responseTime; totalTAT += turnaroundTime;
-        output << task.identifier << ';' << task.serviceDuration << ';' << task.arrivalMoment << ';' << task.tier << ';' << task.priority << ';'
-            << ' ' << task.delayAccumulated << ';' << ' ' << task.finishMoment << ';' << ' ' << responseTime << ';' << ' ' << turnaroundTime << '\n';
+bool TaskReader::next(Task& task){
+    while (getline(input, line)){
+        task = Task{};
+        if (parseRecord(line.data(), line.data() + line.size(), ++lineCount, task)) return true;
     }
-    double taskCount = static_cast<double>(taskList.size());
-    output << fixed << setprecision(1);
-    output << "WT=" << (totalWT / taskCount) << "; CT=" << (totalCT / taskCount) << "; RT=" << (totalRT / taskCount) << "; TAT=" << (totalTAT / taskCount) << ";\n";
+    return false;
 }
 
-PerformanceMetrics calculateMetrics(const vector<Task>& taskList){
-    long long totalWT = 0, totalCT = 0, totalRT = 0, totalTAT = 0;
-    for (const auto& task : taskList){
-        int responseTime  = (task.startMoment < 0 ? 0 : (task.startMoment - task.arrivalMoment));
-        int turnaroundTime = (task.finishMoment < 0 ? 0 : (task.finishMoment - task.arrivalMoment));
-        totalWT += task.delayAccumulated; totalCT += task.finishMoment; totalRT += responseTime; totalTAT += turnaroundTime;
+// The RT column (and its mean) is the raw first-run time, as in the original report
+void writeTaskLine(ReportWriter& output, const Task& task){
+    int responseTime  = (task.startMoment < 0 ? 0 : (task.startMoment));
+    int turnaroundTime = (task.finishMoment < 0 ? 0 : (task.finishMoment - task.arrivalMoment));
+    output << task.identifier << ';' << task.serviceDuration << ';' << task.arrivalMoment << ';' << task.tier << ';' << task.priority << ';'
+        << ' ' << task.delayAccumulated << ';' << ' ' << task.finishMoment << ';' << ' ' << responseTime << ';' << ' ' << turnaroundTime << '\n';
+}
+
+void writeTaskLine(ostream& output, const Task& task){
+    ReportWriter writer(output);
+    writeTaskLine(writer, task);
+}
+
+void writeMeansLine(ReportWriter& output, const MetricsAccumulator& metrics){
+    double taskCount = static_cast<double>(metrics.tasks);
+    using Fixed = ReportWriter::Fixed;
+    output << "WT=" << Fixed{metrics.waitingTotal / taskCount, 1} << "; CT=" << Fixed{metrics.completionTotal / taskCount, 1}
+           << "; RT=" << Fixed{metrics.startTotal / taskCount, 1} << "; TAT=" << Fixed{metrics.turnaroundTotal / taskCount, 1} << ";\n";
+}
+
+void writeMeansLine(ostream& output, const MetricsAccumulator& metrics){
+    ReportWriter writer(output);
+    writeMeansLine(writer, metrics);
+}
+
+static void writeTailLatencyReport(ReportWriter& output, const vector<pair<char, const MetricsAccumulator*>>& schemes){
+    output << "\n📉 Tail Latency\n";
+    output << "algorithm; metric; p50; p90; p99; p99.9; max\n";
+    for (const auto& scheme : schemes){
+        const auto& metrics = *scheme.second;
+        const pair<const char*, const LatencyHistogram*> rows[] = {
+            {"WT", &metrics.waiting}, {"RT", &metrics.response}, {"TAT", &metrics.turnaround}};
+        for (const auto& row : rows){
+            const auto& histogram = *row.second;
+            output << scheme.first << "; " << row.first << "; " << histogram.quantile(0.5) << "; " << histogram.quantile(0.9)
+                   << "; " << histogram.quantile(0.99) << "; " << histogram.quantile(0.999) << "; " << histogram.maximum() << "\n";
+        }
+    }
+}
+
+void writeTailLatencyReport(ostream& output, const vector<pair<char, const MetricsAccumulator*>>& schemes){
+    ReportWriter writer(output);
+    writeTailLatencyReport(writer, schemes);
+}
+
+// From time 0 to the last completion: CPU units busy (over N CPUs up to N × 100 %) and completions per 100 units
+static void writeThroughputReport(ReportWriter& output, const vector<pair<char, const MetricsAccumulator*>>& schemes){
+    using Fixed = ReportWriter::Fixed;
+    output << "\n⚙️ Throughput\n";
+    output << "algorithm; busy; makespan; CPU busy %; tasks per 100 units\n";
+    for (const auto& scheme : schemes){
+        const auto& metrics = *scheme.second;
+        double makespan = static_cast<double>(metrics.makespan);
+        double utilization = makespan > 0 ? 100.0 * static_cast<double>(metrics.busyTotal) / makespan : 0.0;
+        double throughput = makespan > 0 ? 100.0 * static_cast<double>(metrics.tasks) / makespan : 0.0;
+        output << scheme.first << "; " << metrics.busyTotal << "; " << metrics.makespan << "; "
+               << Fixed{utilization, 1} << "; " << Fixed{throughput, 2} << "\n";
     }
-    double taskCount = static_cast<double>(taskList.size());
-    PerformanceMetrics metrics{};
-    if(taskCount > 0){
-        metrics.WT  = totalWT / taskCount;
-        metrics.CT  = totalCT / taskCount;
-        metrics.RT  = totalRT / taskCount;
-        metrics.TAT = totalTAT / taskCount;
+}
+
+void writeThroughputReport(ostream& output, const vector<pair<char, const MetricsAccumulator*>>& schemes){
+    ReportWriter writer(output);
+    writeThroughputReport(writer, schemes);
+}
+
+std::string describePolicy(const StarvationPolicy& policy){
+    string description;
+    if (policy.boostInterval > 0) description = "boost=" + to_string(policy.boostInterval);
+    if (policy.agingThreshold > 0) description += (description.empty() ? "aging=" : "+aging=") + to_string(policy.agingThreshold);
+    return description.empty() ? "none" : description;
+}
+
+// What each policy buys in worst-case turnaround and what it costs in mean response
+static void writeStarvationReport(ReportWriter& output, const vector<PolicyOutcome>& outcomes){
+    using Fixed = ReportWriter::Fixed;
+    output << "\n🛡️ Starvation Policies\n";
+    output << "algorithm; policy; RT; TAT; p99 TAT; max TAT; max WT\n";
+    for (const auto& outcome : outcomes){
+        auto means = outcome.metrics.means();
+        output << outcome.scheme << "; " << describePolicy(outcome.policy) << "; " << Fixed{means.RT, 1} << "; "
+               << Fixed{means.TAT, 1} << "; " << outcome.metrics.turnaround.quantile(0.99) << "; "
+               << outcome.metrics.turnaround.maximum() << "; " << outcome.metrics.waiting.maximum() << "\n";
     }
-    return metrics;
+}
+
+void writeStarvationReport(ostream& output, const vector<PolicyOutcome>& outcomes){
+    ReportWriter writer(output);
+    writeStarvationReport(writer, outcomes);
+}
+
+// Per-task rows plus the means line, feeding 'metrics' in the same pass
+static void writeTaskRows(ReportWriter& output, const vector<Task>& taskList, MetricsAccumulator& metrics){
+    for (const auto& task : taskList){
+        metrics.add(task);
+        writeTaskLine(output, task);
+    }
+    writeMeansLine(output, metrics);
+}
+
+void generateReport(ostream& output, const vector<Task>& taskList){
+    MetricsAccumulator metrics;
+    generateReport(output, taskList, metrics);
+}
+
+void generateReport(ostream& output, const vector<Task>& taskList, MetricsAccumulator& metrics){
+    ReportWriter writer(output);
+    writeTaskRows(writer, taskList, metrics);
+}
+
+PerformanceMetrics calculateMetrics(const vector<Task>& taskList){
+    MetricsAccumulator metrics;
+    for (const auto& task : taskList) metrics.add(task);
+    return metrics.means();
 }
 
 std::string algorithmDescription(char algorithmType){
@@ -88,21 +252,64 @@ std::string algorithmDescription(char algorithmType){
     if (algorithmType == 'A') return "A → RR(1), RR(3), RR(4), SJF";
     if (algorithmType == 'B') return "B → RR(2), RR(3), RR(4), STCF";
     if (algorithmType == 'C') return "C → RR(3), RR(5), RR(6), RR(20)";
+    if (const auto* registered = findRegisteredScheme(algorithmType))
+        return string(1, algorithmType) + " → " + describeScheme(*registered);
     return " ";
 }
 
 void writeConsolidatedReport(ostream& output, const vector<pair<char, vector<Task>>>& results) {
-    for (const auto& result : results){
-        output << "📈 Algorithm " << algorithmDescription(result.first) << endl;
+    writeConsolidatedReport(output, results, ReportOptions{});
+}
+
+void writeConsolidatedReport(ostream& stream, const vector<pair<char, vector<Task>>>& results, const ReportOptions& reportOptions) {
+    ReportWriter output(stream);
+    vector<MetricsAccumulator> schemeMetrics(results.size());
+    for (size_t scheme = 0; scheme < results.size(); ++scheme){
+        const auto& result = results[scheme];
+        output << "📈 Algorithm " << algorithmDescription(result.first) << '\n';
         output << "identifier; BT; AT; Q; Pr; WT; CT; RT; TAT\n";
-        generateReport(output, result.second);
+        writeTaskRows(output, result.second, schemeMetrics[scheme]);
         output << "\n";
     }
 
+    using Fixed = ReportWriter::Fixed;
     output << "🏆 Algorithm Comparison\n";
     output << "algorithm; WT; CT; RT; TAT\n";
-    for (const auto& result : results) {
-        auto metrics = calculateMetrics(result.second);
-        output << result.first << "; " << setprecision(1) << metrics.WT << "; " << metrics.CT << "; " << metrics.RT << "; " << metrics.TAT << "\n";
+    for (size_t scheme = 0; scheme < results.size(); ++scheme) {
+        auto metrics = schemeMetrics[scheme].means();
+        output << results[scheme].first << "; " << Fixed{metrics.WT, 1} << "; " << Fixed{metrics.CT, 1} << "; "
+               << Fixed{metrics.RT, 1} << "; " << Fixed{metrics.TAT, 1} << "\n";
+    }
+
+    vector<pair<char, const MetricsAccumulator*>> summaries;
+    bool anyIo = false;
+    for (size_t scheme = 0; scheme < results.size(); ++scheme){
+        summaries.emplace_back(results[scheme].first, &schemeMetrics[scheme]);
+        anyIo |= schemeMetrics[scheme].ioTasks > 0;
+    }
+    if (reportOptions.tailLatency) writeTailLatencyReport(output, summaries);
+    if (reportOptions.throughput || anyIo) writeThroughputReport(output, summaries);
+}
+
+void writeStatisticsReport(ostream& output, const vector<pair<char, SchedulerStatistics>>& statistics){
+    output << "📊 Scheduler Statistics\n";
+    if (!statistics.empty()){
+        const auto& timing = statistics.front().second;
+        output << fixed << setprecision(3) << "parse_ms=" << timing.parseSeconds * 1e3
+               << "; simulate_ms=" << timing.simulateSeconds * 1e3 << "; report_ms=" << timing.reportSeconds * 1e3 << ";\n";
+    }
+    for (const auto& entry : statistics){
+        output << "\n📈 Algorithm " << algorithmDescription(entry.first) << '\n';
+        output << "level; dispatches; demotions; promotions; preemptions; queue length histogram (units at 0, 1, 2-3, 4-7, ...)\n";
+        for (size_t level = 0; level < entry.second.levels.size(); ++level){
+            const auto& counters = entry.second.levels[level];
+            output << level + 1 << "; " << counters.dispatches << "; " << counters.demotions << "; " << counters.promotions << "; "
+                   << counters.preemptions << ";";
+            // Trim empty high buckets
+            size_t used = counters.queueLengthHistogram.size();
+            while (used > 1 && counters.queueLengthHistogram[used - 1] == 0) --used;
+            for (size_t bucket = 0; bucket < used; ++bucket) output << ' ' << counters.queueLengthHistogram[bucket];
+            output << '\n';
+        }
     }
 }
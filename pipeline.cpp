@@ -0,0 +1,30 @@
+#include "pipeline.h"
+#include "engine.h"
+#include <cctype>
+#include <stdexcept>
+
+using namespace std;
+
+// Monomorphic instantiations of the engine loop for the fixed schemes
+
+template <class Pipeline>
+static vector<Task> runPipeline(const vector<Task>& input, const SimulationOptions& options){
+    TaskTable taskTable(input); // interned identifiers, all tasks reset to level 1
+    Pipeline levels(taskTable);
+    simulateMLFQ(taskTable, levels, options);
+    return taskTable.toTasks();
+}
+
+bool hasStaticPipeline(char algorithmType){
+    algorithmType = static_cast<char>(toupper(algorithmType));
+    return algorithmType == 'A' || algorithmType == 'B' || algorithmType == 'C';
+}
+
+vector<Task> executeStaticMLFQ(const vector<Task>& input, char algorithmType, const SimulationOptions& options){
+    switch (toupper(algorithmType)){
+        case 'A': return runPipeline<PipelineA>(input, options);
+        case 'B': return runPipeline<PipelineB>(input, options);
+        case 'C': return runPipeline<PipelineC>(input, options);
+    }
+    throw runtime_error("No compile-time pipeline for scheme (A/B/C).");
+}
@@ -0,0 +1,127 @@
+#pragma once
+#include "mlfq.h"
+#include "RR.h"
+#include "SJF.h"
+#include "STCF.h"
+#include <tuple>
+#include <utility>
+
+// =============================================================
+// Compile-time MLFQ pipelines
+// =============================================================
+//
+// Level strategies and round-robin quanta are template parameters, e.g.
+//   StaticLevels<pipeline::RR<1>, pipeline::RR<3>, pipeline::RR<4>, pipeline::SJF>
+// Every level is stored by value as a final type, so the engine loop in
+// engine.h calls the strategies directly (no virtual dispatch) and can inline them,
+// round-robin quanta included (BasicCircularScheduler<Quantum> stores none).
+namespace pipeline {
+    template <int Quantum>
+    class RR final : public BasicCircularScheduler<Quantum> {
+        static_assert(Quantum > 0, "round-robin quantum must be positive");
+    public:
+        explicit RR(TaskTable& tasks) : BasicCircularScheduler<Quantum>(tasks) {}
+    };
+
+    class SJF final : public MinimalJobScheduler {
+    public:
+        using MinimalJobScheduler::MinimalJobScheduler;
+    };
+
+    class STCF final : public DynamicShortestScheduler {
+    public:
+        using DynamicShortestScheduler::DynamicShortestScheduler;
+    };
+}
+
+template <class... Strategies>
+class StaticLevels {
+    static_assert(sizeof...(Strategies) >= 1 && sizeof...(Strategies) <= MAX_LEVELS, "1 to MAX_LEVELS levels");
+    std::tuple<Strategies...> levels;
+    ReadyLevels ready;  // refreshed by every call that can change a level's queue
+
+    // Call 'action' on the strategy at a runtime level index
+    template <class Action, size_t... Index>
+    void dispatch(int level, Action& action, std::index_sequence<Index...>) {
+        (void)((level == static_cast<int>(Index) ? (action(std::get<Index>(levels)), true) : false) || ...);
+    }
+    template <class Action, size_t... Index>
+    void dispatch(int level, Action& action, std::index_sequence<Index...>) const {
+        (void)((level == static_cast<int>(Index) ? (action(std::get<Index>(levels)), true) : false) || ...);
+    }
+    template <class Action>
+    void at(int level, Action action) { dispatch(level, action, std::index_sequence_for<Strategies...>{}); }
+    template <class Action>
+    void at(int level, Action action) const { dispatch(level, action, std::index_sequence_for<Strategies...>{}); }
+    template <class Action>
+    void each(Action action) { std::apply([&](auto&... strategy){ (action(strategy), ...); }, levels); }
+    template <class Action>
+    void each(Action action) const { std::apply([&](const auto&... strategy){ (action(strategy), ...); }, levels); }
+
+public:
+    static constexpr int depth() { return static_cast<int>(sizeof...(Strategies)); }
+
+    explicit StaticLevels(TaskTable& taskTable) : levels(((void)sizeof(Strategies), taskTable)...) {}
+
+    int  firstReadyLevel() const { return ready.first(); }
+    bool hasWork(int level) const { return ready.has(level); }
+    int queueLength(int level) const {
+        int result = 0;
+        at(level, [&](const auto& strategy){ result = strategy.queueLength(); });
+        return result;
+    }
+    void addToQueue(int level, int taskId) {
+        at(level, [&](auto& strategy){ strategy.addToQueue(taskId); });
+        ready.update(level, true);
+    }
+    int selectNextTask(int level, int currentTaskId) {
+        int result = -1;
+        at(level, [&](auto& strategy){
+            result = strategy.selectNextTask(currentTaskId);
+            ready.update(level, strategy.hasWaitingTasks());
+        });
+        return result;
+    }
+    int peekNextTask(int level) const {
+        int result = -1;
+        at(level, [&](const auto& strategy){ result = strategy.peekNextTask(); });
+        return result;
+    }
+    void processTimeUnit(int level, int taskId) { at(level, [&](auto& strategy){ strategy.processTimeUnit(taskId); }); }
+    void processTimeUnits(int level, int taskId, int units) {
+        at(level, [&](auto& strategy){ strategy.processTimeUnits(taskId, units); });
+    }
+    int runBudget(int level, int taskId) const {
+        int result = 1;
+        at(level, [&](const auto& strategy){ result = strategy.runBudget(taskId); });
+        return result;
+    }
+    void handleTaskExit(int level, int taskId) { at(level, [&](auto& strategy){ strategy.handleTaskExit(taskId); }); }
+    void purgeTask(int level, int taskId) {
+        at(level, [&](auto& strategy){
+            strategy.purgeTask(taskId);
+            ready.update(level, strategy.hasWaitingTasks());
+        });
+    }
+
+    void updateWaitingTimes(int runningTaskId) { each([&](auto& strategy){ strategy.updateWaitingTimes(runningTaskId); }); }
+    void accumulateWaitingTimes(int runningTaskId, int units) {
+        each([&](auto& strategy){ strategy.accumulateWaitingTimes(runningTaskId, units); });
+    }
+    void enableTimestampAccounting(const int* clock) { each([&](auto& strategy){ strategy.enableTimestampAccounting(clock); }); }
+    void reset() { each([](auto& strategy){ strategy.reset(); }); ready.clear(); }
+    void refreshRank(int taskId) { each([&](auto& strategy){ strategy.refreshRank(taskId); }); }
+    void saveState(SavedState& state) const { each([&](const auto& strategy){ strategy.saveState(state); }); }
+    void restoreState(StateReader& state) {
+        int level = 0;
+        each([&](auto& strategy){
+            strategy.restoreState(state);
+            ready.update(level++, strategy.hasWaitingTasks());
+        });
+    }
+};
+
+// The fixed schemes (same levels as defineAlgorithmScheme in mlfq.cpp)
+using PipelineA = StaticLevels<pipeline::RR<1>, pipeline::RR<3>, pipeline::RR<4>, pipeline::SJF>;
+using PipelineB = StaticLevels<pipeline::RR<2>, pipeline::RR<3>, pipeline::RR<4>, pipeline::STCF>;
+using PipelineC = StaticLevels<pipeline::RR<3>, pipeline::RR<5>, pipeline::RR<6>, pipeline::RR<20>>;
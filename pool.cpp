@@ -0,0 +1,87 @@
+#include "pool.h"
+
+using namespace std;
+
+namespace {
+    // Index of the pool worker running on this thread (-1 outside the pool)
+    thread_local int currentWorker = -1;
+    thread_local const WorkStealingPool* currentPool = nullptr;
+}
+
+WorkStealingPool::WorkStealingPool(unsigned threadCount){
+    if (threadCount == 0) threadCount = max(1u, thread::hardware_concurrency());
+    for (unsigned i = 0; i < threadCount; ++i) queues.push_back(make_unique<WorkerQueue>());
+    for (unsigned i = 0; i < threadCount; ++i) workers.emplace_back([this, i]{ workerLoop(i); });
+}
+
+WorkStealingPool::~WorkStealingPool(){
+    {
+        lock_guard<mutex> guard(stateLock);
+        stopping = true;
+    }
+    workAvailable.notify_all();
+    for (auto& worker : workers) worker.join();
+}
+
+void WorkStealingPool::submit(Job job){
+    // Jobs spawned by a worker stay local; external ones are spread round-robin
+    unsigned target = (currentPool == this) ? static_cast<unsigned>(currentWorker)
+                                            : nextQueue.fetch_add(1) % size();
+    {
+        lock_guard<mutex> guard(queues[target]->lock);
+        queues[target]->jobs.push_back(move(job));
+    }
+    {
+        lock_guard<mutex> guard(stateLock);
+        ++queuedJobs; ++pendingJobs;
+    }
+    workAvailable.notify_one();
+}
+
+void WorkStealingPool::wait(){
+    unique_lock<mutex> guard(stateLock);
+    allDone.wait(guard, [this]{ return pendingJobs == 0; });
+}
+
+bool WorkStealingPool::takeJob(unsigned self, Job& job){
+    // Own queue first (newest job), then steal the oldest job from the others
+    {
+        WorkerQueue& own = *queues[self];
+        lock_guard<mutex> guard(own.lock);
+        if (!own.jobs.empty()){
+            job = move(own.jobs.back());
+            own.jobs.pop_back();
+            return true;
+        }
+    }
+    for (unsigned offset = 1; offset < size(); ++offset){
+        WorkerQueue& victim = *queues[(self + offset) % size()];
+        lock_guard<mutex> guard(victim.lock);
+        if (!victim.jobs.empty()){
+            job = move(victim.jobs.front());
+            victim.jobs.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void WorkStealingPool::workerLoop(unsigned self){
+    currentWorker = static_cast<int>(self);
+    currentPool = this;
+    while (true){
+        {
+            unique_lock<mutex> guard(stateLock);
+            workAvailable.wait(guard, [this]{ return stopping || queuedJobs > 0; });
+            if (queuedJobs == 0) return; // stopping and drained
+            --queuedJobs;                // reserve one job; it is in some deque
+        }
+
+        Job job;
+        while (!takeJob(self, job)) this_thread::yield(); // reserved job not visible yet
+        job();
+
+        lock_guard<mutex> guard(stateLock);
+        if (--pendingJobs == 0) allDone.notify_all();
+    }
+}
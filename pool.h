@@ -0,0 +1,51 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// =============================================================
+// Work-stealing thread pool
+// =============================================================
+//
+// Every worker owns a deque: it pops its own newest job (LIFO, cache warm)
+// and, when empty, steals the oldest job from another worker (FIFO).
+// Jobs may submit further jobs; those land on the submitting worker's deque.
+// Jobs must not throw: catch and record errors inside the job.
+class WorkStealingPool {
+public:
+    using Job = std::function<void()>;
+
+    explicit WorkStealingPool(unsigned threadCount = 0); // 0: hardware concurrency
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    void submit(Job job);
+    void wait();                 // block until every submitted job has finished
+    unsigned size() const { return static_cast<unsigned>(workers.size()); }
+
+private:
+    struct WorkerQueue {
+        std::mutex lock;
+        std::deque<Job> jobs;
+    };
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+    std::vector<std::thread> workers;
+    std::atomic<unsigned> nextQueue{0};   // round-robin target for external submissions
+
+    std::mutex stateLock;
+    std::condition_variable workAvailable, allDone;
+    size_t queuedJobs = 0;    // submitted but not yet taken (guarded by stateLock)
+    size_t pendingJobs = 0;   // submitted but not yet finished (guarded by stateLock)
+    bool stopping = false;
+
+    bool takeJob(unsigned self, Job& job);
+    void workerLoop(unsigned self);
+};
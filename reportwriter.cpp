@@ -0,0 +1,53 @@
+#include "reportwriter.h"
+#include <cmath>
+#include <cstdio>
+#include <ostream>
+
+using namespace std;
+
+// Buffered report writer: buffer recycling, stream hand-off and fixed-point doubles
+
+namespace {
+    // Spare buffer per thread: a writer takes it and gives it back, so only
+    // the first report on a thread (or a nested writer) allocates
+    thread_local vector<char> spareBuffer;
+}
+
+ReportWriter::ReportWriter(ostream& os) : output(os) {
+    buffer.swap(spareBuffer);
+    buffer.resize(CAPACITY);
+}
+
+ReportWriter::~ReportWriter(){
+    flush();
+    if (spareBuffer.capacity() < buffer.capacity()) buffer.swap(spareBuffer);
+}
+
+void ReportWriter::flush(){
+    if (used == 0) return;
+    output.write(buffer.data(), static_cast<streamsize>(used));
+    used = 0;
+}
+
+void ReportWriter::writeThrough(string_view text){
+    output.write(text.data(), static_cast<streamsize>(text.size()));
+}
+
+ReportWriter& ReportWriter::operator<<(Fixed number){
+    // Finite values of any magnitude fit after a flush: 309 digits, sign, point, precision
+    if (CAPACITY - used < 512) flush();
+    char* cursor = buffer.data() + used;
+#if defined(__cpp_lib_to_chars)
+    if (isfinite(number.value)) {
+        cursor = to_chars(cursor, buffer.data() + CAPACITY, number.value, chars_format::fixed, number.precision).ptr;
+    } else {
+        // Spelled like the stream does it (printf "%f": "nan", "-nan", "inf", "-inf")
+        cursor += snprintf(cursor, 8, "%.*f", number.precision, number.value);
+    }
+#else
+    // No floating-point to_chars before GCC 11 / VS 2019 16.4: printf rounds the same way
+    cursor += snprintf(cursor, CAPACITY - used, "%.*f", number.precision, number.value);
+#endif
+    used = static_cast<size_t>(cursor - buffer.data());
+    return *this;
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include <charconv>
+#include <cstring>
+#include <iosfwd>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+// =============================================================
+// Buffered report writer
+// =============================================================
+//
+// Fields are formatted with std::to_chars straight into a buffer that is handed
+// to the stream in large writes; no stream state, no per-field virtual calls.
+// Output matches ostream formatting byte for byte: integers as with operator<<,
+// Fixed{value, n} as with 'fixed << setprecision(n)'. The buffer is recycled per
+// thread, so writing report after report allocates nothing once warm.
+class ReportWriter {
+public:
+    static constexpr std::size_t CAPACITY = 1 << 16;
+
+    struct Fixed { double value; int precision; };
+
+    explicit ReportWriter(std::ostream& os);
+    ~ReportWriter();  // flushes into the stream (without flushing the stream itself)
+
+    ReportWriter(const ReportWriter&) = delete;
+    ReportWriter& operator=(const ReportWriter&) = delete;
+
+    ReportWriter& operator<<(char c) {
+        if (used == CAPACITY) flush();
+        buffer[used++] = c;
+        return *this;
+    }
+    ReportWriter& operator<<(std::string_view text) {
+        if (text.size() > CAPACITY - used) {
+            flush();
+            if (text.size() > CAPACITY) { writeThrough(text); return *this; }
+        }
+        std::memcpy(buffer.data() + used, text.data(), text.size());
+        used += text.size();
+        return *this;
+    }
+    ReportWriter& operator<<(const char* text) { return *this << std::string_view(text); }
+
+    template <class Integer, std::enable_if_t<std::is_integral_v<Integer> && !std::is_same_v<Integer, char>, int> = 0>
+    ReportWriter& operator<<(Integer value) {
+        if (CAPACITY - used < 24) flush();
+        used = static_cast<std::size_t>(std::to_chars(buffer.data() + used, buffer.data() + CAPACITY, value).ptr - buffer.data());
+        return *this;
+    }
+    ReportWriter& operator<<(Fixed number);
+
+    void flush();  // hand the buffered bytes to the stream
+
+private:
+    std::ostream& output;
+    std::vector<char> buffer;
+    std::size_t used = 0;
+
+    void writeThrough(std::string_view text);
+};
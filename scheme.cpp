@@ -0,0 +1,89 @@
+#include "mlfq.h"
+#include <cctype>
+#include <map>
+#include <stdexcept>
+
+using namespace std;
+
+// Level configurations given as text, e.g. "RR:2,RR:3,RR:4,STCF"
+
+namespace {
+    // Schemes registered from the command line, looked up by label
+    map<char, LevelScheme>& schemeRegistry(){
+        static map<char, LevelScheme> registry;
+        return registry;
+    }
+
+    string upperCase(string text){
+        for (char& c : text) c = static_cast<char>(toupper(static_cast<unsigned char>(c)));
+        return text;
+    }
+
+    LevelConfiguration parseLevel(const string& token, const string& spec){
+        string name = upperCase(token);
+        if (name == "SJF") return {SchedulingMode::SHORTEST_FIRST, 0};
+        if (name == "STCF") return {SchedulingMode::SHORTEST_REMAINING, 0};
+        if (name.compare(0, 3, "RR:") == 0 && name.size() > 3 && name.size() <= 12
+            && name.find_first_not_of("0123456789", 3) == string::npos){
+            long quantum = stol(name.substr(3));
+            if (quantum > 0 && quantum <= 1000000000) return {SchedulingMode::ROUND_ROBIN, static_cast<int>(quantum)};
+        }
+        throw runtime_error("❌ Invalid scheme '" + spec + "': unknown level '" + token + "' (RR:<quantum>, SJF or STCF)");
+    }
+}
+
+LevelScheme parseSchemeSpec(const string& spec){
+    LevelScheme levels;
+    size_t start = 0;
+    while (true){
+        size_t stop = spec.find(',', start);
+        string token = spec.substr(start, stop == string::npos ? string::npos : stop - start);
+        if (levels.size() == static_cast<size_t>(MAX_LEVELS))
+            throw runtime_error("❌ Invalid scheme '" + spec + "': at most " + to_string(MAX_LEVELS) + " levels");
+        levels.push_back(parseLevel(token, spec));
+        if (stop == string::npos) break;
+        start = stop + 1;
+    }
+    return levels;
+}
+
+string formatSchemeSpec(const LevelScheme& levels){
+    string spec;
+    for (const auto& level : levels){
+        if (!spec.empty()) spec += ',';
+        switch (level.strategy){
+            case SchedulingMode::ROUND_ROBIN: spec += "RR:" + to_string(level.timeSlice); break;
+            case SchedulingMode::SHORTEST_FIRST: spec += "SJF"; break;
+            case SchedulingMode::SHORTEST_REMAINING: spec += "STCF"; break;
+        }
+    }
+    return spec;
+}
+
+string describeScheme(const LevelScheme& levels){
+    string description;
+    for (const auto& level : levels){
+        if (!description.empty()) description += ", ";
+        switch (level.strategy){
+            case SchedulingMode::ROUND_ROBIN: description += "RR(" + to_string(level.timeSlice) + ")"; break;
+            case SchedulingMode::SHORTEST_FIRST: description += "SJF"; break;
+            case SchedulingMode::SHORTEST_REMAINING: description += "STCF"; break;
+        }
+    }
+    return description;
+}
+
+void registerScheme(char label, const LevelScheme& levels){
+    char upper = static_cast<char>(toupper(static_cast<unsigned char>(label)));
+    if (upper == 'A' || upper == 'B' || upper == 'C')
+        throw runtime_error("❌ Scheme label '" + string(1, label) + "' is reserved for the built-in schemes");
+    if (levels.empty() || levels.size() > static_cast<size_t>(MAX_LEVELS))
+        throw runtime_error("❌ Scheme '" + string(1, label) + "' needs 1 to " + to_string(MAX_LEVELS) + " levels");
+    schemeRegistry()[label] = levels;
+}
+
+const LevelScheme* findRegisteredScheme(char label){
+    const auto& registry = schemeRegistry();
+    auto entry = registry.find(label);
+    return entry == registry.end() ? nullptr : &entry->second;
+}
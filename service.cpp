@@ -0,0 +1,192 @@
+#include "mlfq.h"
+#include "mpscqueue.h"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+using namespace std;
+
+// Live scheduler service: lock-free submissions, one scheduler thread over an OnlineScheduler
+
+namespace {
+    using Clock = chrono::steady_clock;
+
+    struct Submission {
+        Task task;
+        Clock::time_point submitted;
+    };
+
+    // Per-slot bookkeeping for the tasks the OnlineScheduler holds
+    struct Pending {
+        uint64_t ticket = 0;
+        Clock::time_point submitted;
+    };
+}
+
+struct SchedulerService::State {
+    ServiceOptions options;
+    MpscRing<Submission> queue;
+    CompletionHandler onComplete;
+    OnlineScheduler scheduler;
+    vector<Pending> pending;     // by scheduler slot (scheduler thread only)
+    uint64_t admitted = 0;       // queue positions drained so far (scheduler thread only)
+    ServiceCompletion completion;
+    Clock::time_point started;
+
+    atomic<int> now{0};
+    atomic<uint64_t> finished{0};
+    atomic<bool> stopping{false};
+
+    // Parking: the scheduler sleeps here only while it has nothing to run,
+    // producers only while the queue is full
+    mutex parkLock;
+    condition_variable wake, spaceFreed;
+    atomic<bool> parked{false};
+    atomic<int> waitingProducers{0};
+
+    thread worker;
+
+    State(char algorithm, const ServiceOptions& serviceOptions, CompletionHandler handler)
+        : options(serviceOptions), queue(max<size_t>(serviceOptions.queueCapacity, 2)), onComplete(move(handler)),
+          scheduler(algorithm, serviceOptions.simulation, [this](int slot, const Task& task){ complete(slot, task); }) {
+        if (options.clock == ServiceClock::WALL && options.unitMicroseconds < 1)
+            throw invalid_argument("❌ Wall-clock service needs a unit of at least 1 microsecond");
+    }
+
+    void complete(int slot, const Task& task){
+        completion.ticket = pending[slot].ticket;
+        completion.task = task;
+        completion.latencyNanoseconds = chrono::duration_cast<chrono::nanoseconds>(Clock::now() - pending[slot].submitted).count();
+        onComplete(completion);
+        finished.fetch_add(1, memory_order_release);
+    }
+
+    // Everything published so far arrives at the current time unit
+    void drain(){
+        Submission submission;
+        bool freed = false;
+        while (queue.tryPop(submission)){
+            submission.task.arrivalMoment = scheduler.now();
+            int slot = scheduler.admit(submission.task);
+            if (slot >= static_cast<int>(pending.size())) pending.resize(slot + 1);
+            pending[slot] = Pending{admitted++, submission.submitted};
+            freed = true;
+        }
+        if (!freed) return;
+        atomic_thread_fence(memory_order_seq_cst); // pairs with the fence in waitForSpace()
+        if (waitingProducers.load() == 0) return;
+        lock_guard<mutex> lock(parkLock);
+        spaceFreed.notify_all();
+    }
+
+    Clock::time_point unitEnd(int unit) const {
+        return started + chrono::microseconds(static_cast<long long>(unit + 1) * options.unitMicroseconds);
+    }
+
+    int elapsedUnits() const {
+        return static_cast<int>(chrono::duration_cast<chrono::microseconds>(Clock::now() - started).count()
+                                / options.unitMicroseconds);
+    }
+
+    // Sleep until a producer publishes something or stop() is called
+    void park(){
+        unique_lock<mutex> lock(parkLock);
+        parked.store(true);
+        atomic_thread_fence(memory_order_seq_cst); // pairs with the fence in notifyParked()
+        if (queue.empty() && !stopping.load()) wake.wait(lock);
+        parked.store(false);
+    }
+
+    // Producer side of a full queue: true once 'submission' is in
+    bool waitForSpace(Submission& submission, size_t& position){
+        unique_lock<mutex> lock(parkLock);
+        waitingProducers.fetch_add(1);
+        atomic_thread_fence(memory_order_seq_cst);
+        bool pushed = queue.tryPush(submission, position);
+        if (!pushed) spaceFreed.wait(lock);
+        waitingProducers.fetch_sub(1);
+        return pushed;
+    }
+
+    void notifyParked(){
+        atomic_thread_fence(memory_order_seq_cst);
+        if (!parked.load()) return;
+        lock_guard<mutex> lock(parkLock);
+        wake.notify_one();
+    }
+
+    void run(){
+        const bool wallClock = options.clock == ServiceClock::WALL;
+        while (true){
+            drain();
+            if (scheduler.liveTasks() == 0){
+                if (stopping.load() && queue.empty()) break;
+                park();
+                if (wallClock) scheduler.advanceTo(max(scheduler.now(), elapsedUnits())); // idle: jump to the present
+                now.store(scheduler.now(), memory_order_relaxed);
+                continue;
+            }
+            if (wallClock){
+                this_thread::sleep_until(unitEnd(scheduler.now()));
+                drain();
+            }
+            scheduler.advanceTo(scheduler.now() + 1);
+            now.store(scheduler.now(), memory_order_relaxed);
+        }
+    }
+};
+
+SchedulerService::SchedulerService(char algorithm, const ServiceOptions& options, CompletionHandler onComplete)
+    : state(make_unique<State>(algorithm, options, move(onComplete))) {
+    State& s = *state;
+    s.started = Clock::now();
+    s.worker = thread([&s]{ s.run(); });
+}
+
+SchedulerService::~SchedulerService(){ stop(); }
+
+uint64_t SchedulerService::submit(Task task){
+    State& s = *state;
+    if (s.stopping.load()) throw logic_error("❌ Task submitted to a stopped scheduler service");
+    Submission submission{move(task), Clock::now()};
+    size_t position = 0;
+    // Queue full: yield a few times, then sleep until the scheduler drains it
+    for (int attempt = 0; !s.queue.tryPush(submission, position); ++attempt){
+        if (attempt < 2) this_thread::yield();
+        else if (s.waitForSpace(submission, position)) break;
+    }
+    s.notifyParked();
+    return position;
+}
+
+bool SchedulerService::trySubmit(Task& task, uint64_t& ticket){
+    State& s = *state;
+    if (s.stopping.load()) throw logic_error("❌ Task submitted to a stopped scheduler service");
+    Submission submission{move(task), Clock::now()};
+    size_t position = 0;
+    if (!s.queue.tryPush(submission, position)){
+        task = move(submission.task);
+        return false;
+    }
+    s.notifyParked();
+    ticket = position;
+    return true;
+}
+
+void SchedulerService::stop(){
+    State& s = *state;
+    if (!s.worker.joinable()) return;
+    s.stopping.store(true);
+    {
+        lock_guard<mutex> lock(s.parkLock);
+        s.wake.notify_one();
+    }
+    s.worker.join();
+}
+
+int SchedulerService::now() const { return state->now.load(memory_order_relaxed); }
+uint64_t SchedulerService::submitted() const { return state->queue.claimed(); }
+uint64_t SchedulerService::completed() const { return state->finished.load(memory_order_acquire); }
@@ -0,0 +1,121 @@
+#include "mlfq.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Live service stress test: producer threads submit synthetic tasks to a SchedulerService
+// as fast as it accepts them; reports sustained submissions per second and the
+// submit-to-completion latency, and checks that every ticket completes exactly once.
+//
+//   stress [--producers=N] [--tasks=N] [--scheme=A] [--clock=simulated|wall] [--unit-us=U]
+//          [--queue=N] [--burst=MEAN] [--seed=S]
+//
+// --tasks is per producer. Exit status 1 if a ticket is lost or completed twice.
+
+using namespace std;
+
+namespace {
+    using Clock = chrono::steady_clock;
+
+    void printLatency(const char* name, const LatencyHistogram& histogram){
+        printf("%-9s %10.1f %10.1f %10.1f %10.1f %10.1f\n", name,
+               histogram.quantile(0.50) / 1e3, histogram.quantile(0.90) / 1e3, histogram.quantile(0.99) / 1e3,
+               histogram.quantile(0.999) / 1e3, histogram.maximum() / 1e3);
+    }
+}
+
+int main(int argc, char** argv){
+    unsigned producerCount = max(2u, thread::hardware_concurrency()) - 1;
+    size_t tasksPerProducer = 100000;
+    char scheme = 'A';
+    ServiceOptions options;
+    options.simulation.engine = EngineMode::EVENT;
+    options.simulation.waitAccounting = WaitAccounting::TIMESTAMP;
+    WorkloadSpec spec;
+    spec.meanBurst = 2.0;
+
+    auto hasPrefix = [](const string& text, const char* prefix){
+        return text.compare(0, strlen(prefix), prefix) == 0;
+    };
+    for (int argIndex = 1; argIndex < argc; ++argIndex){
+        string argument = argv[argIndex];
+        string value = argument.substr(argument.find('=') + 1);
+        if (hasPrefix(argument, "--producers=")) producerCount = static_cast<unsigned>(strtoul(value.c_str(), nullptr, 10));
+        else if (hasPrefix(argument, "--tasks=")) tasksPerProducer = strtoull(value.c_str(), nullptr, 10);
+        else if (hasPrefix(argument, "--scheme=") && value.size() == 1) scheme = value[0];
+        else if (argument == "--clock=simulated") options.clock = ServiceClock::SIMULATED;
+        else if (argument == "--clock=wall") options.clock = ServiceClock::WALL;
+        else if (hasPrefix(argument, "--unit-us=")) options.unitMicroseconds = atoi(value.c_str());
+        else if (hasPrefix(argument, "--queue=")) options.queueCapacity = strtoull(value.c_str(), nullptr, 10);
+        else if (hasPrefix(argument, "--burst=")) spec.meanBurst = strtod(value.c_str(), nullptr);
+        else if (hasPrefix(argument, "--seed=")) spec.seed = strtoull(value.c_str(), nullptr, 10);
+        else { cerr << "unknown argument: " << argument << '\n'; return 1; }
+    }
+    if (producerCount < 1 || tasksPerProducer < 1) return 1;
+
+    spec.taskCount = producerCount * tasksPerProducer;
+    const vector<Task> workload = generateWorkload(spec);
+
+    // Completions run on the scheduler thread only: no synchronisation needed here
+    vector<char> seen(workload.size(), 0);
+    size_t duplicates = 0, inconsistent = 0;
+    LatencyHistogram latency;
+    Clock::time_point lastCompletion;
+
+    try {
+        SchedulerService service(scheme, options, [&](const ServiceCompletion& done){
+            if (done.ticket >= seen.size() || seen[done.ticket]++) ++duplicates;
+            const Task& task = done.task;
+            if (task.finishMoment - task.arrivalMoment < task.serviceDuration || task.startMoment < task.arrivalMoment) ++inconsistent;
+            latency.add(done.latencyNanoseconds);
+            lastCompletion = Clock::now();
+        });
+
+        atomic<unsigned> ready{0};
+        atomic<bool> go{false};
+        vector<double> producerSeconds(producerCount);
+        vector<thread> producers;
+        for (unsigned producer = 0; producer < producerCount; ++producer){
+            producers.emplace_back([&, producer]{
+                ++ready;
+                while (!go.load()) this_thread::yield();
+                auto start = Clock::now();
+                for (size_t index = producer * tasksPerProducer; index < (producer + 1) * tasksPerProducer; ++index)
+                    service.submit(workload[index]);
+                producerSeconds[producer] = chrono::duration<double>(Clock::now() - start).count();
+            });
+        }
+        while (ready.load() < producerCount) this_thread::yield();
+        auto start = Clock::now();
+        go.store(true);
+        for (auto& producer : producers) producer.join();
+        double submitSeconds = chrono::duration<double>(Clock::now() - start).count();
+        service.stop();
+        double drainSeconds = chrono::duration<double>(lastCompletion - start).count();
+
+        size_t lost = static_cast<size_t>(count(seen.begin(), seen.end(), 0));
+        printf("# producers=%u tasks=%zu scheme=%c clock=%s queue=%zu burst=%.1f\n", producerCount, workload.size(), scheme,
+               options.clock == ServiceClock::WALL ? "wall" : "simulated", options.queueCapacity, spec.meanBurst);
+        printf("submitted  %zu in %.3f s: %.0f submissions/s (slowest producer %.3f s)\n", workload.size(), submitSeconds,
+               workload.size() / submitSeconds, *max_element(producerSeconds.begin(), producerSeconds.end()));
+        printf("completed  %llu in %.3f s: %.0f completions/s, simulated time %d\n",
+               static_cast<unsigned long long>(service.completed()), drainSeconds, service.completed() / drainSeconds, service.now());
+        printf("%-9s %10s %10s %10s %10s %10s\n", "latency", "p50_us", "p90_us", "p99_us", "p99.9_us", "max_us");
+        printLatency("submit", latency);
+        if (lost || duplicates || inconsistent){
+            printf("FAILED: %zu lost, %zu duplicate tickets, %zu inconsistent rows\n", lost, duplicates, inconsistent);
+            return 1;
+        }
+    } catch (const exception& error){
+        cerr << error.what() << '\n';
+        return 3;
+    }
+    return 0;
+}
@@ -0,0 +1,161 @@
+#pragma once
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include "mlfq.h"
+
+// =============================================================
+// Indexed binary min-heap of task IDs for the shortest-first levels
+// =============================================================
+//
+// Ordered by (burstLeft, arrivalMoment, identifier), with insertion order as
+// the last key so full ties resolve like the first-in-list linear scan did.
+// Keys of queued tasks never change (only running and blocked tasks' do),
+// so insert, extract-min and arbitrary delete are all O(log n).
+//
+// Entries carry their key inline, packed at insertion: (burstLeft, arrivalMoment)
+// in one word, then the identifier rank, so sifting compares contiguous 16-byte
+// entries (both children share a cache line) without indexing the task columns.
+// The insertion stamp lives in a side column and is read only on full ties.
+class IndexedTaskHeap {
+    struct Entry {
+        std::uint64_t primary;  // burstLeft << 32 | arrivalMoment, order-preserving unsigned
+        std::uint32_t rank;     // identifier rank, order-preserving unsigned
+        int taskId;
+    };
+
+    const TaskTable& tasks;
+    std::vector<Entry> heap;
+    std::vector<int> slot;                  // heap position per task ID (-1: absent)
+    std::vector<unsigned long long> order;  // insertion stamp per task ID
+    unsigned long long insertions = 0;
+
+    // Signed to unsigned with the same order
+    static std::uint32_t ordered(int value) { return static_cast<std::uint32_t>(value) ^ 0x80000000u; }
+
+    bool before(const Entry& a, const Entry& b) const {
+        if (a.primary != b.primary) return a.primary < b.primary;
+        if (a.rank != b.rank) return a.rank < b.rank;
+        return order[a.taskId] < order[b.taskId];
+    }
+
+    Entry entryFor(int taskId) const {
+        Entry entry;
+        entry.primary = static_cast<std::uint64_t>(ordered(tasks.burstLeft[taskId])) << 32 | ordered(tasks.arrivalMoment[taskId]);
+        entry.rank = ordered(tasks.identifierRank[taskId]);
+        entry.taskId = taskId;
+        return entry;
+    }
+
+    void place(int position, const Entry& entry) { heap[position] = entry; slot[entry.taskId] = position; }
+
+    void siftUp(int position) {
+        Entry entry = heap[position];
+        while (position > 0) {
+            int parent = (position - 1) / 2;
+            if (!before(entry, heap[parent])) break;
+            place(position, heap[parent]);
+            position = parent;
+        }
+        place(position, entry);
+    }
+
+    void siftDown(int position) {
+        Entry entry = heap[position];
+        int count = static_cast<int>(heap.size());
+        while (true) {
+            int child = 2 * position + 1;
+            if (child >= count) break;
+            if (child + 1 < count && before(heap[child + 1], heap[child])) ++child;
+            if (!before(heap[child], entry)) break;
+            place(position, heap[child]);
+            position = child;
+        }
+        place(position, entry);
+    }
+
+public:
+    explicit IndexedTaskHeap(const TaskTable& allTasks) : tasks(allTasks) {}
+
+    // Empty again, sized for the current table; storage is kept
+    void reset() {
+        heap.clear();
+        slot.assign(tasks.size(), -1);
+        order.assign(tasks.size(), 0);
+        insertions = 0;
+    }
+
+    // Strict (burstLeft, arrivalMoment, identifier rank) order, without insertion stamps
+    bool precedes(int a, int b) const { return tasks.precedes(a, b); }
+
+    bool empty() const { return heap.empty(); }
+    int  size() const { return static_cast<int>(heap.size()); }
+    int  top() const { return heap.empty() ? -1 : heap.front().taskId; }
+    bool contains(int taskId) const {
+        return taskId >= 0 && taskId < static_cast<int>(slot.size()) && slot[taskId] >= 0;
+    }
+
+    // Visit every queued task ID, in no particular order
+    template <class Visit>
+    void forEach(Visit visit) const {
+        for (const Entry& entry : heap) visit(entry.taskId);
+    }
+
+    void push(int taskId) {
+        if (taskId >= static_cast<int>(slot.size())) {
+            slot.resize(std::max(tasks.size(), taskId + 1), -1);
+            order.resize(slot.size(), 0);
+        }
+        order[taskId] = insertions++;
+        heap.push_back(entryFor(taskId));
+        siftUp(static_cast<int>(heap.size()) - 1);
+    }
+
+    bool erase(int taskId) {
+        if (!contains(taskId)) return false;
+        int position = slot[taskId];
+        slot[taskId] = -1;
+        Entry last = heap.back();
+        heap.pop_back();
+        if (position < static_cast<int>(heap.size())) {
+            place(position, last);
+            siftUp(position);
+            siftDown(slot[last.taskId]);
+        }
+        return true;
+    }
+
+    int pop() {
+        int taskId = top();
+        if (taskId != -1) erase(taskId);
+        return taskId;
+    }
+
+    // Checkpoints: entries in heap order with their stamps; keys are rebuilt from the
+    // table on restore (queued tasks' keys do not change while they wait)
+    void saveState(SavedState& state) const {
+        state.put(size());
+        for (const Entry& entry : heap) { state.put(entry.taskId); state.putWide(static_cast<long long>(order[entry.taskId])); }
+        state.putWide(static_cast<long long>(insertions));
+    }
+
+    void restoreState(StateReader& state) {
+        reset();
+        for (int count = state.next(); count > 0; --count) {
+            int taskId = state.next();
+            if (taskId >= static_cast<int>(slot.size())) {
+                slot.resize(taskId + 1, -1);
+                order.resize(slot.size(), 0);
+            }
+            order[taskId] = static_cast<unsigned long long>(state.nextWide());
+            slot[taskId] = size();
+            heap.push_back(entryFor(taskId));
+        }
+        insertions = static_cast<unsigned long long>(state.nextWide());
+    }
+
+    // A task's identifier rank was renumbered without changing its order (streaming): re-read it
+    void refreshRank(int taskId) {
+        if (contains(taskId)) heap[slot[taskId]].rank = ordered(tasks.identifierRank[taskId]);
+    }
+};
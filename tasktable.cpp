@@ -0,0 +1,151 @@
+#include "mlfq.h"
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+
+using namespace std;
+
+// Task table: identifier interning and conversion to/from Task records
+
+static int firstBurst(const Task& task){
+    return task.bursts.empty() ? task.serviceDuration : task.bursts.front();
+}
+
+void internIdentifiers(const vector<Task>& tasks, vector<int>& ranks, vector<int>& order){
+    order.resize(tasks.size());
+    iota(order.begin(), order.end(), 0);
+    sort(order.begin(), order.end(), [&](int x, int y){ return tasks[x].identifier < tasks[y].identifier; });
+
+    ranks.resize(tasks.size());
+    int rank = -1;
+    for (size_t i = 0; i < order.size(); ++i){
+        if (i == 0 || tasks[order[i - 1]].identifier != tasks[order[i]].identifier) ++rank;
+        ranks[order[i]] = rank;
+    }
+}
+
+vector<int> internIdentifiers(const vector<Task>& tasks){
+    vector<int> ranks, order;
+    internIdentifiers(tasks, ranks, order);
+    return ranks;
+}
+
+void TaskTable::load(const vector<Task>& tasks){
+    internIdentifiers(tasks, identifierRank, internOrder);
+    initialise(tasks);
+}
+
+void TaskTable::load(const vector<Task>& tasks, const vector<int>& ranks){
+    identifierRank = ranks;
+    initialise(tasks);
+}
+
+void TaskTable::load(const PreparedWorkload& workload){
+    *this = workload.initialTable(); // vector assignment keeps this table's storage
+}
+
+void TaskTable::initialise(const vector<Task>& tasks){
+    source = &tasks;
+    size_t count = tasks.size();
+
+    // === Initialization: all tasks start at level 1 ===
+    timeLeft.resize(count);
+    arrivalMoment.resize(count);
+    burstLeft.resize(count);
+    for (size_t i = 0; i < count; ++i){
+        timeLeft[i] = tasks[i].serviceDuration;
+        arrivalMoment[i] = tasks[i].arrivalMoment;
+        burstLeft[i] = firstBurst(tasks[i]);
+    }
+    tier.assign(count, 1);  // top level
+    delayAccumulated.assign(count, 0);
+    readySince.assign(count, -1);
+    startMoment.assign(count, -1);
+    finishMoment.assign(count, -1);
+    burstIndex.assign(count, 0);
+}
+
+void TaskTable::assign(int taskId, const Task& task, int rank){
+    if (taskId == size()){
+        for (auto* column : {&timeLeft, &arrivalMoment, &tier, &delayAccumulated, &readySince,
+                             &identifierRank, &burstLeft, &startMoment, &finishMoment, &burstIndex})
+            column->push_back(0);
+    }
+    // === Same initial state as load(): level 1, nothing run yet ===
+    timeLeft[taskId] = task.serviceDuration;
+    arrivalMoment[taskId] = task.arrivalMoment;
+    tier[taskId] = 1;
+    delayAccumulated[taskId] = 0;
+    readySince[taskId] = -1;
+    identifierRank[taskId] = rank;
+    burstLeft[taskId] = firstBurst(task);
+    startMoment[taskId] = -1;
+    finishMoment[taskId] = -1;
+    burstIndex[taskId] = 0;
+}
+
+int TaskTable::beginIo(int taskId){
+    const auto& bursts = (*source)[taskId].bursts;
+    int io = bursts[burstIndex[taskId] + 1];
+    burstIndex[taskId] += 2;
+    burstLeft[taskId] = bursts[burstIndex[taskId]];
+    return io;
+}
+
+void TaskTable::saveRunState(SavedState& state, int time) const {
+    int arrived = 0;
+    for (int moment : arrivalMoment) arrived += moment < time;
+    size_t position = state.words.size();
+    state.words.resize(position + 1 + static_cast<size_t>(arrived) * 9);
+    int* word = state.words.data() + position;
+    *word++ = arrived;
+    for (int taskId = 0; taskId < size(); ++taskId){
+        if (arrivalMoment[taskId] >= time) continue;
+        *word++ = taskId;
+        *word++ = timeLeft[taskId];      *word++ = tier[taskId];
+        *word++ = delayAccumulated[taskId]; *word++ = readySince[taskId];
+        *word++ = burstLeft[taskId];     *word++ = startMoment[taskId];
+        *word++ = finishMoment[taskId];  *word++ = burstIndex[taskId];
+    }
+}
+
+void TaskTable::restoreRunState(StateReader& state){
+    for (int arrived = state.next(); arrived > 0; --arrived){
+        int taskId = state.next();
+        if (taskId < 0 || taskId >= size()) throw runtime_error("❌ Checkpoint task out of range.");
+        timeLeft[taskId] = state.next();      tier[taskId] = state.next();
+        delayAccumulated[taskId] = state.next(); readySince[taskId] = state.next();
+        burstLeft[taskId] = state.next();     startMoment[taskId] = state.next();
+        finishMoment[taskId] = state.next();  burstIndex[taskId] = state.next();
+    }
+}
+
+Task TaskTable::task(int taskId) const {
+    Task record = (*source)[taskId];
+    record.tier = tier[taskId];
+    record.timeLeft = timeLeft[taskId];
+    record.startMoment = startMoment[taskId];
+    record.finishMoment = finishMoment[taskId];
+    record.delayAccumulated = delayAccumulated[taskId];
+    return record;
+}
+
+vector<Task> TaskTable::toTasks() const {
+    vector<Task> records;
+    records.reserve(timeLeft.size());
+    for (int taskId = 0; taskId < size(); ++taskId) records.push_back(task(taskId));
+    return records;
+}
+
+void TaskTable::toTasks(vector<Task>& records) const {
+    records.resize(timeLeft.size());
+    for (int taskId = 0; taskId < size(); ++taskId){
+        Task& record = records[taskId];
+        record = (*source)[taskId]; // copy-assignment keeps the record's string and burst buffers
+        record.tier = tier[taskId];
+        record.timeLeft = timeLeft[taskId];
+        record.startMoment = startMoment[taskId];
+        record.finishMoment = finishMoment[taskId];
+        record.delayAccumulated = delayAccumulated[taskId];
+    }
+}
@@ -0,0 +1,106 @@
+#include "trace.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+using namespace std;
+
+// Execution trace recorder, file writer and mapped reader
+
+namespace {
+    const char TRACE_MAGIC[8] = {'M', 'L', 'F', 'Q', 'T', 'R', 'C', '1'};
+
+    bool startsBefore(const TraceSegment& a, const TraceSegment& b){
+        if (a.start != b.start) return a.start < b.start;
+        return a.cpu < b.cpu;
+    }
+}
+
+const char* traceExitName(TraceExit reason){
+    switch (reason){
+        case TraceExit::COMPLETED:     return "completed";
+        case TraceExit::PREEMPTED:     return "preempted";
+        case TraceExit::SLICE_EXPIRED: return "slice";
+        case TraceExit::BLOCKED:       return "io";
+    }
+    return "?";
+}
+
+void ExecutionTrace::append(const ExecutionTrace& other){
+    size_t middle = runs.size();
+    runs.insert(runs.end(), other.runs.begin(), other.runs.end());
+    inplace_merge(runs.begin(), runs.begin() + middle, runs.end(), startsBefore);
+}
+
+void writeTraceFile(const string& filepath, const ExecutionTrace& trace, const vector<string>& identifiers){
+    const auto& segments = trace.segments();
+
+    TraceHeader header{};
+    memcpy(header.magic, TRACE_MAGIC, sizeof(TRACE_MAGIC));
+    header.segmentSize = sizeof(TraceSegment);
+    header.taskCount = static_cast<uint32_t>(identifiers.size());
+    header.segmentCount = segments.size();
+    for (const auto& segment : segments){
+        header.maxLength = max(header.maxLength, segment.length);
+        header.makespan = max(header.makespan, segment.end());
+    }
+
+    // === Name table: offsets first, then the identifier bytes ===
+    vector<uint32_t> nameOffsets(identifiers.size() + 1, 0);
+    for (size_t i = 0; i < identifiers.size(); ++i)
+        nameOffsets[i + 1] = nameOffsets[i] + static_cast<uint32_t>(identifiers[i].size());
+
+    ofstream output(filepath, ios::binary);
+    if (!output) throw runtime_error("❌ Unable to write trace: " + filepath);
+    output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    output.write(reinterpret_cast<const char*>(segments.data()), static_cast<streamsize>(segments.size() * sizeof(TraceSegment)));
+    output.write(reinterpret_cast<const char*>(nameOffsets.data()), static_cast<streamsize>(nameOffsets.size() * sizeof(uint32_t)));
+    for (const auto& identifier : identifiers) output.write(identifier.data(), static_cast<streamsize>(identifier.size()));
+    if (!output.flush()) throw runtime_error("❌ Unable to write trace: " + filepath);
+}
+
+TraceFile::TraceFile(const string& filepath) : file(filepath){
+    const char* bytes = file.data();
+    const size_t length = file.size();
+    auto malformed = [&]{ return runtime_error("❌ Not a trace file: " + filepath); };
+
+    if (length < sizeof(TraceHeader) || memcmp(bytes, TRACE_MAGIC, sizeof(TRACE_MAGIC)) != 0) throw malformed();
+    head = reinterpret_cast<const TraceHeader*>(bytes);
+    if (head->segmentSize != sizeof(TraceSegment)) throw malformed();
+
+    // Sections must fit the file; the mapping is page aligned, so every section stays 4-byte aligned
+    const size_t segmentBytes = static_cast<size_t>(head->segmentCount) * sizeof(TraceSegment);
+    const size_t offsetBytes = (static_cast<size_t>(head->taskCount) + 1) * sizeof(uint32_t);
+    if (length - sizeof(TraceHeader) < segmentBytes
+        || length - sizeof(TraceHeader) - segmentBytes < offsetBytes) throw malformed();
+    first = reinterpret_cast<const TraceSegment*>(bytes + sizeof(TraceHeader));
+    nameOffsets = reinterpret_cast<const uint32_t*>(bytes + sizeof(TraceHeader) + segmentBytes);
+    names = bytes + sizeof(TraceHeader) + segmentBytes + offsetBytes;
+    for (uint32_t task = 0; task < head->taskCount; ++task)
+        if (nameOffsets[task] > nameOffsets[task + 1]) throw malformed();
+    if (nameOffsets[head->taskCount] > length - (names - bytes)) throw malformed();
+
+    // Readers index per-task tables with 'task' and window() relies on the order and maxLength
+    for (const TraceSegment* segment = first; segment != end(); ++segment){
+        if (segment->task < 0 || segment->task >= taskCount()) throw malformed();
+        if (segment->length <= 0 || segment->length > head->maxLength || segment->start > INT32_MAX - segment->length) throw malformed();
+        if (segment != first && startsBefore(*segment, segment[-1])) throw malformed();
+    }
+}
+
+string TraceFile::identifier(int task) const {
+    if (task < 0 || task >= taskCount()) return "?";
+    return string(names + nameOffsets[task], nameOffsets[task + 1] - nameOffsets[task]);
+}
+
+pair<const TraceSegment*, const TraceSegment*> TraceFile::window(int from, int to) const {
+    // Starts are sorted and no segment is longer than maxLength
+    const long long earliest = static_cast<long long>(from) - head->maxLength;
+    const TraceSegment* low = lower_bound(begin(), end(), earliest,
+        [](const TraceSegment& segment, long long time){ return segment.start < time; });
+    const TraceSegment* high = lower_bound(low, end(), static_cast<long long>(to),
+        [](const TraceSegment& segment, long long time){ return segment.start < time; });
+    return {low, high};
+}
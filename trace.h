@@ -0,0 +1,101 @@
+#pragma once
+#include "mappedfile.h"
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+// =============================================================
+// Execution trace: run segments of the schedule (Gantt timeline)
+// =============================================================
+//
+// A segment is one uninterrupted run of a task on a CPU: the tick timeline
+// run-length encoded, so the recorder is touched once per context switch
+// (never per tick). Idle time is the gap between segments.
+//
+// File layout (host byte order, fixed width, mmap-friendly; little-endian on x86 and ARM):
+//   TraceHeader
+//   TraceSegment[segmentCount]        sorted by (start, cpu)
+//   uint32_t nameOffsets[taskCount+1] into the name bytes that follow
+//   char names[]                      task identifiers, by task index
+
+enum class TraceExit : std::uint8_t {
+    COMPLETED = 0,      // task finished
+    PREEMPTED = 1,      // a higher level (or a shorter task in STCF) took the CPU
+    SLICE_EXPIRED = 2,  // the level's strategy rotated it out (RR quantum)
+    BLOCKED = 3,        // CPU burst over, the task went to I/O
+};
+const char* traceExitName(TraceExit reason);
+
+struct TraceSegment {
+    std::int32_t task;     // index into the input task list
+    std::int32_t start;    // first time unit run
+    std::int32_t length;   // units run
+    std::uint8_t level;    // 0-based MLFQ level
+    TraceExit reason;
+    std::uint16_t cpu;
+    std::int32_t end() const { return start + length; }
+    bool overlaps(int from, int to) const { return start < to && end() > from; }
+};
+static_assert(sizeof(TraceSegment) == 16, "trace records are 16 bytes on disk");
+
+struct TraceHeader {
+    char magic[8];                 // "MLFQTRC1"
+    std::uint32_t segmentSize;     // sizeof(TraceSegment)
+    std::uint32_t taskCount;
+    std::uint64_t segmentCount;
+    std::int32_t maxLength;        // longest segment (bounds window searches)
+    std::int32_t makespan;         // end of the last segment
+};
+static_assert(sizeof(TraceHeader) == 32, "trace header is 32 bytes on disk");
+
+// Recorder filled by the engine through SimulationOptions::trace
+class ExecutionTrace {
+public:
+    explicit ExecutionTrace(int cpu = 0) : cpuIndex(static_cast<std::uint16_t>(cpu)) {}
+
+    void begin(int task, int level, int time) {
+        openTask = task; openLevel = level; openStart = time;
+    }
+    void end(int time, TraceExit reason) {
+        if (openTask == -1) return;
+        if (time > openStart)
+            runs.push_back({openTask, openStart, time - openStart, static_cast<std::uint8_t>(openLevel), reason, cpuIndex});
+        openTask = -1;
+    }
+
+    void append(const ExecutionTrace& other);  // merge another CPU's segments, kept sorted by (start, cpu)
+    const std::vector<TraceSegment>& segments() const { return runs; }
+
+private:
+    std::vector<TraceSegment> runs;
+    std::uint16_t cpuIndex;
+    int openTask = -1, openLevel = 0, openStart = 0;
+};
+
+// Write 'trace' with the identifiers of the simulated tasks (throws runtime_error on I/O errors)
+void writeTraceFile(const std::string& filepath, const ExecutionTrace& trace, const std::vector<std::string>& identifiers);
+
+// Read-only view of a trace file, mapped in place (throws runtime_error on malformed files)
+class TraceFile {
+public:
+    explicit TraceFile(const std::string& filepath);
+
+    const TraceHeader& header() const { return *head; }
+    const TraceSegment* begin() const { return first; }
+    const TraceSegment* end() const { return first + head->segmentCount; }
+    std::size_t size() const { return static_cast<std::size_t>(head->segmentCount); }
+    int taskCount() const { return static_cast<int>(head->taskCount); }
+    std::string identifier(int task) const;
+
+    // Segments that may overlap [from, to): starts in [from - maxLength, to).
+    // Binary search; filter with TraceSegment::overlaps.
+    std::pair<const TraceSegment*, const TraceSegment*> window(int from, int to) const;
+
+private:
+    MappedFile file;
+    const TraceHeader* head = nullptr;
+    const TraceSegment* first = nullptr;
+    const std::uint32_t* nameOffsets = nullptr;
+    const char* names = nullptr;
+};
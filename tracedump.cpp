@@ -0,0 +1,102 @@
+#include "trace.h"
+#include <algorithm>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <string>
+#include <vector>
+
+// Trace dump: prints the run segments of a --trace file that overlap a time window.
+//
+//   tracedump <file.trace> [--from=T] [--to=T] [--task=ID] [--gantt]
+//
+// Rows are "start; end; cpu; identifier; level; reason" (levels from 1, end exclusive).
+// --gantt draws one line per task instead, one column per time unit with the
+// level it ran at ('.' when not running); windows are limited to 1000 units.
+
+using namespace std;
+
+namespace {
+    const int GANTT_MAX_WIDTH = 1000;
+
+    void printGantt(const TraceFile& trace, const vector<const TraceSegment*>& segments, int from, int to){
+        // Rows in order of first appearance within the window
+        vector<int> rowOf(trace.taskCount(), -1), rowTask;
+        vector<string> rows;
+        for (const TraceSegment* segment : segments){
+            if (rowOf[segment->task] == -1){
+                rowOf[segment->task] = static_cast<int>(rows.size());
+                rowTask.push_back(segment->task);
+                rows.emplace_back(static_cast<size_t>(to - from), '.');
+            }
+            string& row = rows[rowOf[segment->task]];
+            for (int time = max(from, segment->start); time < min(to, segment->end()); ++time)
+                row[time - from] = static_cast<char>('1' + segment->level);
+        }
+
+        size_t labelWidth = 4;
+        for (int task : rowTask) labelWidth = max(labelWidth, trace.identifier(task).size());
+        printf("%-*s |%d\n", static_cast<int>(labelWidth), "task", from);
+        for (size_t row = 0; row < rows.size(); ++row)
+            printf("%-*s |%s|\n", static_cast<int>(labelWidth), trace.identifier(rowTask[row]).c_str(), rows[row].c_str());
+    }
+}
+
+int main(int argc, char** argv){
+    string traceFilePath, taskFilter;
+    int from = 0, to = INT_MAX;
+    bool gantt = false;
+
+    for (int argIndex = 1; argIndex < argc; ++argIndex){
+        const char* argument = argv[argIndex];
+        if (strncmp(argument, "--from=", 7) == 0) from = atoi(argument + 7);
+        else if (strncmp(argument, "--to=", 5) == 0) to = atoi(argument + 5);
+        else if (strncmp(argument, "--task=", 7) == 0) taskFilter = argument + 7;
+        else if (strcmp(argument, "--gantt") == 0) gantt = true;
+        else if (argument[0] != '-' && traceFilePath.empty()) traceFilePath = argument;
+        else {
+            fprintf(stderr, "usage: tracedump <file.trace> [--from=T] [--to=T] [--task=ID] [--gantt]\n");
+            return 1;
+        }
+    }
+    if (traceFilePath.empty() || from >= to) {
+        fprintf(stderr, "usage: tracedump <file.trace> [--from=T] [--to=T] [--task=ID] [--gantt]\n");
+        return 1;
+    }
+
+    try {
+        TraceFile trace(traceFilePath);
+        const TraceHeader& header = trace.header();
+        to = min(to, header.makespan);
+
+        vector<const TraceSegment*> selected;
+        auto candidates = trace.window(from, to);
+        for (const TraceSegment* segment = candidates.first; segment != candidates.second; ++segment){
+            if (!segment->overlaps(from, to)) continue;
+            if (!taskFilter.empty() && trace.identifier(segment->task) != taskFilter) continue;
+            selected.push_back(segment);
+        }
+
+        printf("# %s: %llu segments, %u tasks, makespan %d; window [%d, %d): %zu segments\n",
+               traceFilePath.c_str(), static_cast<unsigned long long>(header.segmentCount), header.taskCount,
+               header.makespan, from, to, selected.size());
+        if (gantt){
+            if (to - from > GANTT_MAX_WIDTH){
+                fprintf(stderr, "tracedump: --gantt needs a window of at most %d units (use --from/--to)\n", GANTT_MAX_WIDTH);
+                return 1;
+            }
+            if (from < to) printGantt(trace, selected, from, to);
+            return 0;
+        }
+        printf("start; end; cpu; identifier; level; reason\n");
+        for (const TraceSegment* segment : selected)
+            printf("%d; %d; %u; %s; %d; %s\n", segment->start, segment->end(), static_cast<unsigned>(segment->cpu),
+                   trace.identifier(segment->task).c_str(), segment->level + 1, traceExitName(segment->reason));
+    } catch (const exception& error){
+        fprintf(stderr, "%s\n", error.what());
+        return 3;
+    }
+    return 0;
+}
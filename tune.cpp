@@ -0,0 +1,241 @@
+#include "mlfq.h"
+#include "engine.h"
+#include "levels.h"
+#include "pool.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <iomanip>
+#include <mutex>
+#include <ostream>
+
+using namespace std;
+
+// Parallel scheme tuner: one pool job per candidate over a shared Pareto front.
+//
+// Pruning: at checkpoints a candidate bounds its final turnaround times from below
+// (finished tasks are exact, the rest still need their remaining burst from now on).
+// If a front member is already at least as good on both the sum and the p99 and
+// strictly better on one, the candidate cannot enter the front and stops. Ties are
+// never pruned, so the final front does not depend on job order. Without I/O every
+// candidate runs the same work on one work-conserving CPU, so they share one
+// makespan; with I/O bursts the CPU idles differently per schedule. The first
+// finished makespan is therefore only a hint for checkpoint placement (halving the
+// distance to it, where the bounds are tight): it never decides what is pruned.
+
+namespace {
+    struct FrontPoint {
+        long long turnaroundTotal, p99Turnaround;
+        LevelScheme levels;
+    };
+
+    struct TuningContext {
+        const PreparedWorkload* workload;  // interning and arrival order are not repeated per candidate
+        SimulationOptions simulation;
+        bool pruning;
+        int checkInterval;                 // checkpoint spacing without a usable makespan hint
+        atomic<int> makespan{-1};          // last finished candidate's makespan: exact for all without I/O
+
+        mutex frontLock;
+        vector<FrontPoint> front;
+        atomic<size_t> frontSize{0};
+    };
+
+    // Denser near the makespan hint, fixed spacing before one is known or once past it
+    // (a schedule with I/O may end later than the candidate that set the hint)
+    int followingCheckpoint(const TuningContext& context, int now){
+        int makespan = context.makespan.load(memory_order_relaxed);
+        if (makespan <= now) return now + context.checkInterval;
+        return now + max(1, max((makespan - now) / 2, makespan / 256));
+    }
+
+    bool dominates(long long total, long long p99, long long otherTotal, long long otherP99){
+        return total <= otherTotal && p99 <= otherP99 && (total < otherTotal || p99 < otherP99);
+    }
+
+    size_t p99Rank(size_t count){ return max<size_t>(1, min(count, (count * 99 + 99) / 100)); } // ceil(0.99 n)
+
+    long long nearestRankP99(vector<long long>& values){
+        size_t rank = p99Rank(values.size());
+        nth_element(values.begin(), values.begin() + (rank - 1), values.end());
+        return values[rank - 1];
+    }
+
+    // Whether the p99 of 'values' is at least 'threshold' (strictly above with 'strict'),
+    // by counting instead of selecting
+    bool p99Reaches(const vector<long long>& values, long long threshold, bool strict){
+        size_t below = 0;
+        for (long long value : values) below += strict ? (value <= threshold) : (value < threshold);
+        return below < p99Rank(values.size());
+    }
+
+    // Per-task turnaround times into 'scratch' (lower bounds for tasks unfinished at 'now').
+    // Returns a bound on their sum: the tasks already in the system share one CPU, so
+    // their completions are at best the shortest-remaining-first sequence from 'now'.
+    long long turnaroundBounds(const TaskTable& taskTable, int now, vector<long long>& scratch, vector<int>& backlog){
+        long long total = 0;
+        backlog.clear();
+        for (int taskId = 0; taskId < taskTable.size(); ++taskId){
+            const int arrival = taskTable.arrivalMoment[taskId];
+            if (taskTable.finishMoment[taskId] >= 0){
+                scratch[taskId] = taskTable.finishMoment[taskId] - arrival;
+                total += scratch[taskId];
+            } else if (arrival < now){
+                scratch[taskId] = now - arrival + taskTable.timeLeft[taskId];
+                backlog.push_back(taskTable.timeLeft[taskId]);
+                total -= arrival;
+            } else {
+                scratch[taskId] = taskTable.timeLeft[taskId];
+                total += scratch[taskId];
+            }
+        }
+        sort(backlog.begin(), backlog.end());
+        long long completion = now;
+        for (int remaining : backlog){
+            completion += remaining;
+            total += completion;
+        }
+        return total;
+    }
+
+    // Smallest front p99 among members with a smaller turnaround sum, and among those with an equal one
+    pair<long long, long long> pruneThresholds(TuningContext& context, long long total){
+        lock_guard<mutex> guard(context.frontLock);
+        pair<long long, long long> thresholds{LLONG_MAX, LLONG_MAX};
+        for (const auto& point : context.front){
+            if (point.turnaroundTotal < total) thresholds.first = min(thresholds.first, point.p99Turnaround);
+            else if (point.turnaroundTotal == total) thresholds.second = min(thresholds.second, point.p99Turnaround);
+        }
+        return thresholds;
+    }
+
+    void offerToFront(TuningContext& context, const FrontPoint& candidate){
+        lock_guard<mutex> guard(context.frontLock);
+        for (const auto& point : context.front)
+            if (dominates(point.turnaroundTotal, point.p99Turnaround, candidate.turnaroundTotal, candidate.p99Turnaround)) return;
+        context.front.erase(remove_if(context.front.begin(), context.front.end(), [&](const FrontPoint& point){
+            return dominates(candidate.turnaroundTotal, candidate.p99Turnaround, point.turnaroundTotal, point.p99Turnaround);
+        }), context.front.end());
+        context.front.push_back(candidate);
+        context.frontSize = context.front.size();
+    }
+
+    // Returns false when the candidate was pruned
+    bool evaluateCandidate(TuningContext& context, const LevelScheme& configuration){
+        TaskTable taskTable;
+        taskTable.load(*context.workload);
+        const vector<int>& arrivalSequence = context.workload->arrivalSequence();
+        DynamicLevels levels(configuration, taskTable);
+        MLFQCore<DynamicLevels> cpu(taskTable, levels, context.simulation);
+        vector<long long> scratch(taskTable.size());
+        vector<int> backlog;
+
+        size_t nextArrivalIndex = 0;
+        int currentTime = 0, nextCheck = followingCheckpoint(context, 0);
+        while (cpu.completedTasks() < taskTable.size()){
+            while (nextArrivalIndex < arrivalSequence.size() && taskTable.arrivalMoment[arrivalSequence[nextArrivalIndex]] == currentTime){
+                cpu.admit(arrivalSequence[nextArrivalIndex], currentTime);
+                ++nextArrivalIndex;
+            }
+            int horizon = nextArrivalIndex < arrivalSequence.size()
+                ? taskTable.arrivalMoment[arrivalSequence[nextArrivalIndex]] : MLFQCore<DynamicLevels>::NO_HORIZON;
+            if (context.pruning) horizon = min(horizon, nextCheck);
+            currentTime += cpu.advance(currentTime, horizon);
+
+            if (context.pruning && currentTime >= nextCheck && cpu.completedTasks() < taskTable.size()){
+                nextCheck = followingCheckpoint(context, currentTime);
+                if (context.frontSize.load(memory_order_relaxed) == 0) continue;
+                long long totalBound = turnaroundBounds(taskTable, currentTime, scratch, backlog);
+                auto thresholds = pruneThresholds(context, totalBound);
+                if (thresholds.first != LLONG_MAX && p99Reaches(scratch, thresholds.first, false)) return false;
+                if (thresholds.second != LLONG_MAX && p99Reaches(scratch, thresholds.second, true)) return false;
+            }
+        }
+
+        context.makespan.store(currentTime, memory_order_relaxed);
+        long long total = turnaroundBounds(taskTable, currentTime, scratch, backlog);
+        offerToFront(context, FrontPoint{total, nearestRankP99(scratch), configuration});
+        return true;
+    }
+
+    // RR quanta never shrink from one level to the next; the last level may also be SJF or STCF
+    vector<LevelScheme> enumerateCandidates(vector<int> quanta){
+        sort(quanta.begin(), quanta.end());
+        quanta.erase(unique(quanta.begin(), quanta.end()), quanta.end());
+        quanta.erase(remove_if(quanta.begin(), quanta.end(), [](int quantum){ return quantum <= 0; }), quanta.end());
+
+        vector<LevelScheme> candidates;
+        const size_t count = quanta.size();
+        for (size_t first = 0; first < count; ++first)
+            for (size_t second = first; second < count; ++second)
+                for (size_t third = second; third < count; ++third){
+                    LevelScheme levels(4);
+                    levels[0] = {SchedulingMode::ROUND_ROBIN, quanta[first]};
+                    levels[1] = {SchedulingMode::ROUND_ROBIN, quanta[second]};
+                    levels[2] = {SchedulingMode::ROUND_ROBIN, quanta[third]};
+                    levels[3] = {SchedulingMode::SHORTEST_FIRST, 0};        candidates.push_back(levels);
+                    levels[3] = {SchedulingMode::SHORTEST_REMAINING, 0};    candidates.push_back(levels);
+                    for (size_t last = third; last < count; ++last){
+                        levels[3] = {SchedulingMode::ROUND_ROBIN, quanta[last]};
+                        candidates.push_back(levels);
+                    }
+                }
+        return candidates;
+    }
+}
+
+TuningResult tuneSchemes(const vector<Task>& workload, const TuningOptions& options){
+    return tuneSchemes(PreparedWorkload(workload), options);
+}
+
+TuningResult tuneSchemes(const PreparedWorkload& workload, const TuningOptions& options){
+    auto startTime = chrono::steady_clock::now();
+    TuningResult result;
+
+    TuningContext context;
+    context.workload = &workload;
+    context.simulation = options.simulation;
+    context.simulation.statistics = nullptr;
+    context.simulation.trace = nullptr;
+    context.pruning = options.pruning;
+    long long totalBurst = 0;
+    for (const auto& task : workload.tasks()) totalBurst += max(0, task.serviceDuration);
+    context.checkInterval = static_cast<int>(min<long long>(1000000000, max<long long>(1, totalBurst / 16)));
+
+    const auto candidates = enumerateCandidates(options.quanta);
+    result.candidates = candidates.size();
+    if (workload.size() > 0){
+        vector<char> pruned(candidates.size(), 0);
+        WorkStealingPool pool(options.threadCount);
+        for (size_t index = 0; index < candidates.size(); ++index)
+            pool.submit([&context, &candidates, &pruned, index]{
+                if (!evaluateCandidate(context, candidates[index])) pruned[index] = 1;
+            });
+        pool.wait();
+        result.pruned = static_cast<size_t>(count(pruned.begin(), pruned.end(), 1));
+    }
+
+    sort(context.front.begin(), context.front.end(), [](const FrontPoint& x, const FrontPoint& y){
+        if (x.turnaroundTotal != y.turnaroundTotal) return x.turnaroundTotal < y.turnaroundTotal;
+        if (x.p99Turnaround != y.p99Turnaround) return x.p99Turnaround < y.p99Turnaround;
+        return formatSchemeSpec(x.levels) < formatSchemeSpec(y.levels);
+    });
+    for (const auto& point : context.front){
+        TuningCandidate candidate;
+        candidate.levels = point.levels;
+        candidate.meanTurnaround = static_cast<double>(point.turnaroundTotal) / workload.size();
+        candidate.p99Turnaround = point.p99Turnaround;
+        result.front.push_back(candidate);
+    }
+    result.wallSeconds = chrono::duration<double>(chrono::steady_clock::now() - startTime).count();
+    return result;
+}
+
+void writeTuningReport(ostream& output, const TuningResult& result){
+    output << "🎯 Pareto Front (mean TAT, p99 TAT)\n";
+    output << "mean TAT; p99 TAT; scheme\n";
+    for (const auto& candidate : result.front)
+        output << fixed << setprecision(1) << candidate.meanTurnaround << "; " << candidate.p99Turnaround
+               << "; " << formatSchemeSpec(candidate.levels) << '\n';
+}
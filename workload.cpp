@@ -0,0 +1,70 @@
+#include "mlfq.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <ostream>
+#include <random>
+
+using namespace std;
+
+// Synthetic workload generator
+
+namespace {
+    // Bursty arrivals: short clusters of back-to-back tasks separated by long gaps,
+    // keeping the same long-run arrival rate as the Poisson pattern
+    constexpr double burstClusterMean = 8.0;
+
+    // Pareto shape for heavy-tailed bursts (finite mean, infinite variance)
+    constexpr double paretoShape = 1.5;
+
+    int drawBurst(mt19937_64& random, const WorkloadSpec& spec){
+        double burst;
+        if (spec.bursts == BurstDistribution::EXPONENTIAL){
+            burst = exponential_distribution<double>(1.0 / spec.meanBurst)(random);
+        } else {
+            double scale = spec.meanBurst * (paretoShape - 1.0) / paretoShape;
+            double uniform = uniform_real_distribution<double>(numeric_limits<double>::min(), 1.0)(random);
+            burst = scale / pow(uniform, 1.0 / paretoShape);
+        }
+        return static_cast<int>(min(1e9, max(1.0, ceil(burst))));
+    }
+}
+
+vector<Task> generateWorkload(const WorkloadSpec& spec){
+    mt19937_64 random(spec.seed);
+    vector<Task> tasks(spec.taskCount);
+
+    double clock = 0.0;
+    size_t clusterLeft = 0;
+    for (size_t i = 0; i < tasks.size(); ++i){
+        if (i > 0){
+            if (spec.arrivals == ArrivalPattern::POISSON){
+                clock += exponential_distribution<double>(1.0 / spec.meanInterarrival)(random);
+            } else if (clusterLeft > 0){
+                --clusterLeft; // same instant as the previous task
+            } else {
+                clusterLeft = geometric_distribution<size_t>(1.0 / burstClusterMean)(random);
+                clock += exponential_distribution<double>(1.0 / (spec.meanInterarrival * burstClusterMean))(random);
+            }
+        }
+
+        Task& task = tasks[i];
+        task.identifier = "T" + to_string(i);
+        task.serviceDuration = drawBurst(random, spec);
+        task.arrivalMoment = static_cast<int>(min(1e9, floor(clock)));
+        task.tier = 1;
+        task.priority = uniform_int_distribution<int>(1, 5)(random);
+        task.timeLeft = task.serviceDuration;
+    }
+    return tasks;
+}
+
+void writeTaskFile(ostream& output, const vector<Task>& tasks){
+    output << "# etiqueta; burst time (BT); arrival time (AT); Queue (Q); Priority (5 > 1)\n";
+    for (const auto& task : tasks){
+        output << task.identifier << "; " << task.serviceDuration << "; " << task.arrivalMoment << "; "
+               << task.tier << "; " << task.priority;
+        for (size_t i = 0; i < task.bursts.size(); ++i) output << (i == 0 ? "; " : ",") << task.bursts[i];
+        output << '\n';
+    }
+}